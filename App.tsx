@@ -2,7 +2,7 @@ import '@/polyfills/localStorage'; // Must be first — before any Zustand store
 import 'react-native-gesture-handler';
 import '@/i18n'; // Initialize i18n
 import React, { useState, useEffect } from 'react';
-import { StyleSheet } from 'react-native';
+import { InteractionManager, StyleSheet } from 'react-native';
 import { loadStoredLanguagePreference } from '@/i18n';
 import { StatusBar } from 'expo-status-bar';
 import { GestureHandlerRootView } from 'react-native-gesture-handler';
@@ -10,11 +10,16 @@ import { SafeAreaProvider } from 'react-native-safe-area-context';
 import { QueryClient, QueryClientProvider } from '@tanstack/react-query';
 import { AuthProvider } from '@/context/AuthContext';
 import { ApiProvider } from '@/context/ApiContext';
-import { useAuth } from '@/context/AuthContext';
+import { useAuthSelector } from '@/stores/authStore';
 import { ThemeProvider } from '@sudobility/building_blocks_rn';
 import { AppNavigator } from '@/navigation';
 import SplashScreen from '@/screens/SplashScreen';
 import { initializeAllServices } from '@/di/initializeServices';
+import { startActiveSpan } from '@/services/tracing';
+
+// Parent of the API requests made while the app starts; ends once the first
+// screen has mounted and settled.
+const startupSpan = startActiveSpan('app.startup');
 
 // Create a QueryClient instance
 const queryClient = new QueryClient({
@@ -33,7 +38,13 @@ const styles = StyleSheet.create({
 });
 
 function AppContent() {
-  const { isReady } = useAuth();
+  const isReady = useAuthSelector((auth) => auth.isReady);
+
+  useEffect(() => {
+    if (!isReady) return;
+    const task = InteractionManager.runAfterInteractions(() => startupSpan.end());
+    return () => task.cancel();
+  }, [isReady]);
 
   if (!isReady) {
     return <SplashScreen />;
@@ -25,8 +25,10 @@ import {
 } from 'react-native';
 import { SafeAreaView } from 'react-native-safe-area-context';
 import { useTranslation } from 'react-i18next';
-import { useAuth } from '@/context/AuthContext';
+import { useAuthSelector } from '@/stores/authStore';
+import { logAnalyticsEvent } from '@/di/initializeServices';
 import { useAppColors } from '@/hooks/useAppColors';
+import { cancelAuthentication } from '@/native/WebAuth';
 import GoogleIcon from '@/components/GoogleIcon';
 
 /** Props for the AuthModal component. */
@@ -49,7 +51,9 @@ export interface AuthModalProps {
 export default function AuthModal({ visible, onDismiss, initialMode = 'signin' }: AuthModalProps) {
   const { t } = useTranslation();
   const appColors = useAppColors();
-  const { signInWithGoogle, signInWithEmail, signUpWithEmail } = useAuth();
+  const signInWithGoogle = useAuthSelector((auth) => auth.signInWithGoogle);
+  const signInWithEmail = useAuthSelector((auth) => auth.signInWithEmail);
+  const signUpWithEmail = useAuthSelector((auth) => auth.signUpWithEmail);
 
   const [authMode, setAuthMode] = useState<'signin' | 'signup'>(initialMode);
   const [email, setEmail] = useState('');
@@ -66,6 +70,15 @@ export default function AuthModal({ visible, onDismiss, initialMode = 'signin' }
     onDismiss();
   }, [onDismiss]);
 
+  /**
+   * Dismiss from the header's Cancel button. A Google sign-in still waiting
+   * in the browser is abandoned, so it resolves instead of timing out.
+   */
+  const handleCancel = useCallback(() => {
+    cancelAuthentication();
+    handleDismiss();
+  }, [handleDismiss]);
+
   /** Submit email/password authentication (sign-in or sign-up). */
   const handleAuthSubmit = useCallback(async () => {
     if (!email.trim() || !password.trim()) {
@@ -77,8 +90,10 @@ export default function AuthModal({ visible, onDismiss, initialMode = 'signin' }
     try {
       if (authMode === 'signin') {
         await signInWithEmail(email, password);
+        logAnalyticsEvent('login', { method: 'email' });
       } else {
         await signUpWithEmail(email, password);
+        logAnalyticsEvent('sign_up', { method: 'email' });
       }
       handleDismiss();
     } catch (error: unknown) {
@@ -109,7 +124,7 @@ export default function AuthModal({ visible, onDismiss, initialMode = 'signin' }
   const modalContent = (
     <SafeAreaView style={[styles.modalContainer, { backgroundColor: appColors.background }]}>
       <View style={[styles.modalHeader, { borderBottomColor: appColors.border, backgroundColor: appColors.card }]}>
-        <Pressable onPress={handleDismiss} accessibilityRole="button" accessibilityLabel={t('common.cancel')}>
+        <Pressable onPress={handleCancel} accessibilityRole="button" accessibilityLabel={t('common.cancel')}>
           <Text style={[styles.modalCancel, { color: appColors.primary }]}>{t('common.cancel')}</Text>
         </Pressable>
         <Text style={[styles.modalTitle, { color: appColors.text }]}>
@@ -208,7 +223,7 @@ export default function AuthModal({ visible, onDismiss, initialMode = 'signin' }
       visible={visible}
       animationType="slide"
       presentationStyle="pageSheet"
-      onRequestClose={handleDismiss}
+      onRequestClose={handleCancel}
     >
       {modalContent}
     </Modal>
@@ -16,6 +16,9 @@ export const SUPPORTED_LANGUAGES = [
 export const STORAGE_KEYS = {
   LANGUAGE: '@starter/language',
   SETTINGS: '@starter/settings',
+  ANALYTICS_QUEUE: '@starter/analytics-queue',
+  AUTH_SESSION: '@starter/auth-session',
+  BACKUP: '@starter/backup',
 } as const;
 
 // Tab names
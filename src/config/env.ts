@@ -25,6 +25,14 @@ export const env = {
   FIREBASE_MESSAGING_SENDER_ID: getEnv('EXPO_PUBLIC_FIREBASE_MESSAGING_SENDER_ID'),
   FIREBASE_APP_ID: getEnv('EXPO_PUBLIC_FIREBASE_APP_ID'),
 
+  // Analytics collector for desktop builds (events are only persisted when empty)
+  ANALYTICS_URL: getEnv('EXPO_PUBLIC_ANALYTICS_URL'),
+
+  // OTLP/HTTP (JSON) endpoint for client request spans (spans are dropped when empty)
+  TRACES_URL: getEnv('EXPO_PUBLIC_TRACES_URL'),
+  // W3C `tracestate` carried by every trace this app starts (omitted when empty)
+  TRACE_STATE: getEnv('EXPO_PUBLIC_TRACE_STATE'),
+
   // Development
   DEV_MODE: getEnv('EXPO_PUBLIC_DEV_MODE', 'false') === 'true',
 };
@@ -6,12 +6,19 @@
  * authenticated API calls without prop-drilling.
  *
  * The network client is created once and remains stable across re-renders.
- * The token and userId are refreshed whenever the auth state changes.
+ * It attaches the latest ID token to API requests itself (see
+ * {@link getAuthToken}), so Firebase token rotation does not change the
+ * context value. The token and userId only change on sign-in / sign-out.
  */
 
 import React, { createContext, useContext, useMemo } from 'react';
 import type { NetworkClient, NetworkResponse, NetworkRequestOptions, Optional } from '@sudobility/types';
 import { env } from '@/config/env';
+import { getAuthToken } from '@/services/authToken';
+import { reportNetworkError, shouldFailFast } from '@/services/reachability';
+import { endRequestSpan, startRequestSpan } from '@/services/tracing';
+import { isLocalUrl, isSameOrigin } from '@/utils/origin';
+import { serializeBody } from '@/utils/requestBody';
 import { useAuth } from './AuthContext';
 
 /** Values exposed by the API context to descendant components. */
@@ -20,7 +27,10 @@ export interface ApiContextValue {
   networkClient: NetworkClient;
   /** The base URL for the starter API (e.g. `http://localhost:3001`). */
   baseUrl: string;
-  /** The current Firebase ID token, or `null` if not authenticated. */
+  /**
+   * The Firebase ID token obtained at sign-in, or `null` if not authenticated.
+   * Requests to {@link baseUrl} always carry the latest token regardless.
+   */
   token: string | null;
   /** The current user's UID, or `null` if not authenticated. */
   userId: string | null;
@@ -30,15 +40,60 @@ export interface ApiContextValue {
   isLoading: boolean;
 }
 
+/**
+ * Whether `url` goes to the starter API, and so may carry the ID token and
+ * trace headers. Compares origins exactly; never true when `API_URL` is
+ * empty.
+ */
+function isApiRequest(url: string): boolean {
+  return isSameOrigin(url, env.API_URL);
+}
+
+/**
+ * Build the request headers, replacing any caller-supplied `Authorization`
+ * header with the latest ID token for requests to the API.
+ *
+ * Callers such as `useHistoriesManager` build their headers from the token
+ * they were rendered with, which may have rotated since.
+ *
+ * @param url - The fully-qualified request URL.
+ * @param headers - Headers supplied by the caller.
+ * @returns The headers to send.
+ */
+function buildHeaders(url: string, headers?: NetworkRequestOptions['headers']): Record<string, string> {
+  const result: Record<string, string> = {
+    'Content-Type': 'application/json',
+    ...headers,
+  };
+  const token = getAuthToken();
+  if (token && isApiRequest(url)) {
+    for (const key of Object.keys(result)) {
+      if (key.toLowerCase() === 'authorization') delete result[key];
+    }
+    result.Authorization = `Bearer ${token}`;
+  }
+  return result;
+}
+
 /**
  * Execute an HTTP request using the Fetch API and return a typed {@link NetworkResponse}.
  *
- * Automatically sets `Content-Type: application/json` and parses the response
+ * Automatically sets `Content-Type: application/json`, attaches the current
+ * ID token for API requests (see {@link buildHeaders}), and parses the response
  * body as JSON. When the response is not OK, the function attempts to extract
  * a human-readable error message from the JSON body (`error` or `message` field).
  * If the body cannot be parsed as JSON, the raw response text is included as
  * the error message instead of a generic `HTTP {status}` string.
  *
+ * When the device is reported offline and a recent request has already
+ * failed with a network error (see {@link shouldFailFast}), requests to
+ * internet hosts are not attempted and a failed response with status `0` is
+ * returned immediately. Loopback and private-network hosts are always tried.
+ *
+ * API requests are traced: each gets a client span whose `traceparent`
+ * header is sent to the server, with time-to-first-byte and download time
+ * recorded when the span ends.
+ *
  * @typeParam T - The expected shape of the successful response data.
  * @param url - The fully-qualified URL to request.
  * @param options - Optional request configuration (method, headers, body, signal).
@@ -51,19 +106,41 @@ async function makeRequest<T>(
   const method = options?.method ?? 'GET';
   const body = options?.body as BodyInit | undefined;
 
-  const response = await fetch(url, {
-    method,
-    headers: {
-      'Content-Type': 'application/json',
-      ...options?.headers,
-    },
-    body,
-    signal: options?.signal,
-  });
+  if (shouldFailFast() && !isLocalUrl(url)) {
+    return {
+      success: false,
+      error: 'Network unavailable',
+      timestamp: new Date().toISOString(),
+      ok: false,
+      status: 0,
+      statusText: 'Offline',
+      headers: {},
+    };
+  }
+
+  const headers = buildHeaders(url, options?.headers);
+  const trace = isApiRequest(url) ? startRequestSpan(method, url) : null;
+  if (trace) Object.assign(headers, trace.headers);
+  const start = Date.now();
 
-  const headers: Record<string, string> = {};
+  let response: Response;
+  try {
+    response = await fetch(url, {
+      method,
+      headers,
+      body,
+      signal: options?.signal,
+    });
+  } catch (fetchError) {
+    if ((fetchError as Error)?.name !== 'AbortError' && !isLocalUrl(url)) reportNetworkError();
+    if (trace) endRequestSpan(trace.span, 0, { start, end: Date.now() });
+    throw fetchError;
+  }
+  const headersReceived = Date.now();
+
+  const responseHeaders: Record<string, string> = {};
   response.headers.forEach((value, key) => {
-    headers[key] = value;
+    responseHeaders[key] = value;
   });
 
   let data: T | undefined;
@@ -89,6 +166,10 @@ async function makeRequest<T>(
     }
   }
 
+  if (trace) {
+    endRequestSpan(trace.span, response.status, { start, headers: headersReceived, end: Date.now() });
+  }
+
   return {
     success: response.ok,
     data,
@@ -97,7 +178,7 @@ async function makeRequest<T>(
     ok: response.ok,
     status: response.status,
     statusText: response.statusText,
-    headers,
+    headers: responseHeaders,
   };
 }
 
@@ -105,8 +186,8 @@ async function makeRequest<T>(
  * Create a fetch-based {@link NetworkClient} that conforms to the
  * `@sudobility/types` interface.
  *
- * Each HTTP method delegates to {@link makeRequest}, automatically
- * serializing request bodies as JSON for `POST` and `PUT` requests.
+ * Each HTTP method delegates to {@link makeRequest}, serializing request
+ * bodies as JSON for `POST` and `PUT` requests via {@link serializeBody}.
  *
  * @returns A stateless {@link NetworkClient} instance.
  */
@@ -126,14 +207,14 @@ const createNetworkClient = (): NetworkClient => ({
     body?: Optional<unknown>,
     options?: Optional<Omit<NetworkRequestOptions, 'method'>>
   ): Promise<NetworkResponse<T>> =>
-    makeRequest(url, { ...options, method: 'POST', body: body ? JSON.stringify(body) : undefined }),
+    makeRequest(url, { ...options, method: 'POST', body: serializeBody(body) }),
 
   put: <T,>(
     url: string,
     body?: Optional<unknown>,
     options?: Optional<Omit<NetworkRequestOptions, 'method'>>
   ): Promise<NetworkResponse<T>> =>
-    makeRequest(url, { ...options, method: 'PUT', body: body ? JSON.stringify(body) : undefined }),
+    makeRequest(url, { ...options, method: 'PUT', body: serializeBody(body) }),
 
   delete: <T,>(
     url: string,
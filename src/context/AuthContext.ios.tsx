@@ -14,6 +14,9 @@ import React, {
   useMemo,
 } from 'react';
 import auth, { type FirebaseAuthTypes } from '@react-native-firebase/auth';
+import { scheduleInterval } from '@/services/scheduler';
+import { setAuthToken } from '@/services/authToken';
+import { usePublishAuthState } from '@/stores/authStore';
 
 // Lazy-load Google Sign-In to avoid crash when native module isn't linked yet
 let googleSignInConfigured = false;
@@ -77,12 +80,15 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
       if (firebaseUser) {
         try {
           const idToken = await firebaseUser.getIdToken();
+          setAuthToken(idToken);
           setToken(idToken);
         } catch (error) {
           console.error('[Auth] Error getting ID token:', error);
+          setAuthToken(null);
           setToken(null);
         }
       } else {
+        setAuthToken(null);
         setToken(null);
       }
 
@@ -97,19 +103,20 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
   useEffect(() => {
     if (!user) return;
 
-    const refreshInterval = setInterval(async () => {
+    // Refresh every 50 minutes; may share a wake-up with other timers for up
+    // to 5 minutes since the token stays valid for 60.
+    const refreshTimer = scheduleInterval(async () => {
       try {
         const currentUser = auth().currentUser;
         if (currentUser) {
-          const newToken = await currentUser.getIdToken(true);
-          setToken(newToken);
+          setAuthToken(await currentUser.getIdToken(true));
         }
       } catch (error) {
         console.error('Error refreshing token:', error);
       }
-    }, 50 * 60 * 1000); // Refresh every 50 minutes
+    }, 50 * 60 * 1000, { toleranceMs: 5 * 60 * 1000 });
 
-    return () => clearInterval(refreshInterval);
+    return () => refreshTimer.cancel();
   }, [user]);
 
   const signInWithGoogle = useCallback(async () => {
@@ -164,7 +171,7 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
 
     try {
       const newToken = await currentUser.getIdToken(true);
-      setToken(newToken);
+      setAuthToken(newToken);
       return newToken;
     } catch (error) {
       console.error('Error refreshing token:', error);
@@ -196,6 +203,9 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
     refreshToken,
   ]);
 
+  // Mirror into the auth store for selector-based consumers (useAuthSelector)
+  usePublishAuthState(value);
+
   return (
     <AuthContext.Provider value={value}>
       {children}
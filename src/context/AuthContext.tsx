@@ -1,8 +1,10 @@
 /**
  * AuthContext - Firebase Authentication for Desktop (macOS / Windows)
  *
- * Uses Firebase JS SDK (`firebase/auth`) instead of native @react-native-firebase/auth.
- * Google Sign-In uses the PKCE OAuth flow via WebAuth native module.
+ * Talks to the Firebase Auth REST API via {@link FirebaseAuthRestClient}
+ * instead of native @react-native-firebase/auth or the (much heavier)
+ * Firebase JS SDK. Google Sign-In uses the PKCE OAuth flow via WebAuth
+ * native module.
  *
  * Provides {@link AuthProvider} and {@link useAuth} for accessing auth state
  * and performing sign-in, sign-up, sign-out, and password reset operations
@@ -17,25 +19,14 @@ import React, {
   useCallback,
   useMemo,
 } from 'react';
-import { initializeApp, type FirebaseApp } from 'firebase/app';
-import {
-  initializeAuth,
-  signInWithEmailAndPassword,
-  createUserWithEmailAndPassword,
-  signInWithCredential,
-  signOut as firebaseSignOut,
-  sendPasswordResetEmail as firebaseSendPasswordResetEmail,
-  onAuthStateChanged,
-  type Auth,
-  type User,
-  // @ts-expect-error – getReactNativePersistence is exported at runtime
-  getReactNativePersistence,
-} from 'firebase/auth';
-import AsyncStorage from '@react-native-async-storage/async-storage';
 import { FIREBASE_CONFIG } from '@/config/env';
+import { FirebaseAuthRestClient, type AuthSession } from '@/services/firebaseAuthRest';
 import { signInWithGoogleOAuth } from '@/services/googleAuth';
+import { scheduleInterval } from '@/services/scheduler';
+import { setAuthToken } from '@/services/authToken';
+import { usePublishAuthState } from '@/stores/authStore';
 
-/** Serialisable subset of the Firebase User for consumption by components. */
+/** Serialisable Firebase user profile for consumption by components. */
 export interface AuthUser {
   uid: string;
   email: string | null;
@@ -52,7 +43,13 @@ export interface AuthContextValue {
   isLoading: boolean;
   /** Whether the initial auth state has been determined (Firebase listener fired at least once). */
   isReady: boolean;
-  /** The current Firebase ID token, or `null` if not authenticated. */
+  /**
+   * The Firebase ID token obtained at sign-in, or `null` if not authenticated.
+   *
+   * Only changes on sign-in / sign-out. Refreshed tokens are published via
+   * `setAuthToken` and attached to API requests by the network client, so
+   * token rotation does not re-render consumers.
+   */
   token: string | null;
   /** Initiate Google Sign-In via the PKCE OAuth flow. */
   signInWithGoogle: () => Promise<void>;
@@ -70,43 +67,39 @@ export interface AuthContextValue {
 
 const AuthContext = createContext<AuthContextValue | null>(null);
 
-// Lazy Firebase initialization
-let app: FirebaseApp | null = null;
-let firebaseAuth: Auth | null = null;
+// Lazy client initialization
+let authClient: FirebaseAuthRestClient | null = null;
 
 /**
- * Lazily initialise the Firebase app and auth instance.
+ * Lazily create the Firebase Auth REST client.
  *
  * Returns `null` when the Firebase API key is not configured (e.g. in
  * test environments), allowing the app to render without Firebase.
  *
- * @returns The Firebase {@link Auth} instance, or `null`.
+ * @returns The {@link FirebaseAuthRestClient}, or `null`.
  */
-function getFirebaseAuth(): Auth | null {
+function getFirebaseAuth(): FirebaseAuthRestClient | null {
   if (!FIREBASE_CONFIG.apiKey) return null;
-  if (!app) {
-    app = initializeApp(FIREBASE_CONFIG);
-    firebaseAuth = initializeAuth(app, {
-      persistence: getReactNativePersistence(AsyncStorage),
-    });
+  if (!authClient) {
+    authClient = new FirebaseAuthRestClient({ apiKey: FIREBASE_CONFIG.apiKey });
   }
-  return firebaseAuth;
+  return authClient;
 }
 
 /**
- * Convert a Firebase {@link User} into a plain {@link AuthUser} object.
+ * Convert an {@link AuthSession} into a plain {@link AuthUser} object.
  *
- * @param firebaseUser - The Firebase user, or `null` if signed out.
+ * @param session - The session, or `null` if signed out.
  * @returns A serialisable {@link AuthUser}, or `null`.
  */
-function toAuthUser(firebaseUser: User | null): AuthUser | null {
-  if (!firebaseUser) return null;
+function toAuthUser(session: AuthSession | null): AuthUser | null {
+  if (!session) return null;
   return {
-    uid: firebaseUser.uid,
-    email: firebaseUser.email,
-    displayName: firebaseUser.displayName,
-    photoURL: firebaseUser.photoURL,
-    isAnonymous: firebaseUser.isAnonymous,
+    uid: session.uid,
+    email: session.email,
+    displayName: session.displayName,
+    photoURL: session.photoURL,
+    isAnonymous: session.isAnonymous,
   };
 }
 
@@ -114,8 +107,9 @@ function toAuthUser(firebaseUser: User | null): AuthUser | null {
  * Context provider that manages Firebase Authentication state and exposes
  * auth operations to the component tree.
  *
- * Sets up an `onAuthStateChanged` listener on mount and a periodic token
- * refresh every 50 minutes (Firebase tokens expire after 60 minutes).
+ * Restores the persisted session on mount, listens for sign-in / sign-out,
+ * and sets up a periodic token refresh every 50 minutes (Firebase tokens
+ * expire after 60 minutes).
  *
  * @param children - The React child elements to render inside the provider.
  */
@@ -124,7 +118,7 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
   const [token, setToken] = useState<string | null>(null);
   const [isLoading, setIsLoading] = useState(true);
   const [isReady, setIsReady] = useState(false);
-  const [rawUser, setRawUser] = useState<User | null>(null);
+  const [uid, setUid] = useState<string | null>(null);
 
   // Listen to auth state changes
   useEffect(() => {
@@ -135,53 +129,70 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
       return;
     }
 
-    const unsubscribe = onAuthStateChanged(auth, async (firebaseUser) => {
-      setUser(toAuthUser(firebaseUser));
-      setRawUser(firebaseUser);
+    let active = true;
+    const unsubscribe = auth.onSessionChanged(async (session) => {
+      setUser(toAuthUser(session));
+      setUid(session?.uid ?? null);
 
-      if (firebaseUser) {
+      if (session) {
         try {
-          const idToken = await firebaseUser.getIdToken();
+          // Refreshes first if the persisted token has expired
+          const idToken = await auth.getIdToken();
+          if (!active || auth.currentSession?.uid !== session.uid) return;
+          setAuthToken(idToken);
           setToken(idToken);
         } catch (error) {
           console.error('[Auth] Error getting ID token:', error);
+          if (!active) return;
+          setAuthToken(null);
           setToken(null);
         }
       } else {
+        setAuthToken(null);
         setToken(null);
       }
 
+      if (!active) return;
       setIsLoading(false);
       setIsReady(true);
     });
+    auth.restore();
 
-    return unsubscribe;
+    return () => {
+      active = false;
+      unsubscribe();
+    };
   }, []);
 
   // Refresh token periodically (Firebase tokens expire after 1 hour)
   useEffect(() => {
-    if (!rawUser) return;
+    const auth = getFirebaseAuth();
+    if (!auth || !uid) return;
 
-    const refreshInterval = setInterval(async () => {
+    // Refresh every 50 minutes; may share a wake-up with other timers for up
+    // to 5 minutes since the token stays valid for 60.
+    const refreshTimer = scheduleInterval(async () => {
       try {
-        const newToken = await rawUser.getIdToken(true);
-        setToken(newToken);
+        // null when the session changed mid-refresh; the session listener
+        // publishes the new user's token.
+        const newToken = await auth.getIdToken(true);
+        if (newToken) setAuthToken(newToken);
       } catch (error) {
         console.error('Error refreshing token:', error);
       }
-    }, 50 * 60 * 1000); // Refresh every 50 minutes
+    }, 50 * 60 * 1000, { toleranceMs: 5 * 60 * 1000 });
 
-    return () => clearInterval(refreshInterval);
-  }, [rawUser]);
+    return () => refreshTimer.cancel();
+  }, [uid]);
 
   const signInWithGoogle = useCallback(async () => {
     const auth = getFirebaseAuth();
     if (!auth) throw new Error('Firebase not configured');
     setIsLoading(true);
     try {
-      const credential = await signInWithGoogleOAuth();
-      if (credential) {
-        await signInWithCredential(auth, credential);
+      const googleIdToken = await signInWithGoogleOAuth();
+      if (googleIdToken) {
+        await auth.signInWithGoogleIdToken(googleIdToken);
       }
     } finally {
       setIsLoading(false);
@@ -193,7 +204,7 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
     if (!auth) throw new Error('Firebase not configured');
     setIsLoading(true);
     try {
-      await signInWithEmailAndPassword(auth, email, password);
+      await auth.signInWithPassword(email, password);
     } finally {
       setIsLoading(false);
     }
@@ -204,7 +215,7 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
     if (!auth) throw new Error('Firebase not configured');
     setIsLoading(true);
     try {
-      await createUserWithEmailAndPassword(auth, email, password);
+      await auth.signUp(email, password);
     } finally {
       setIsLoading(false);
     }
@@ -215,7 +226,7 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
     if (!auth) return;
     setIsLoading(true);
     try {
-      await firebaseSignOut(auth);
+      await auth.signOut();
     } finally {
       setIsLoading(false);
     }
@@ -224,20 +235,21 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
   const sendPasswordResetEmail = useCallback(async (email: string) => {
     const auth = getFirebaseAuth();
     if (!auth) throw new Error('Firebase not configured');
-    await firebaseSendPasswordResetEmail(auth, email);
+    await auth.sendPasswordResetEmail(email);
   }, []);
 
   const refreshToken = useCallback(async () => {
-    if (!rawUser) return null;
+    const auth = getFirebaseAuth();
+    if (!auth || !uid) return null;
     try {
-      const newToken = await rawUser.getIdToken(true);
-      setToken(newToken);
+      const newToken = await auth.getIdToken(true);
+      if (newToken) setAuthToken(newToken);
       return newToken;
     } catch (error) {
       console.error('Error refreshing token:', error);
       return null;
     }
-  }, [rawUser]);
+  }, [uid]);
 
   const value = useMemo<AuthContextValue>(() => ({
     user,
@@ -263,6 +275,9 @@ export function AuthProvider({ children }: { children: React.ReactNode }) {
     refreshToken,
   ]);
 
+  // Mirror into the auth store for selector-based consumers (useAuthSelector)
+  usePublishAuthState(value);
+
   return (
     <AuthContext.Provider value={value}>
       {children}
@@ -10,10 +10,26 @@ import {
   type FirebaseAnalyticsService,
 } from '@sudobility/di_rn';
 import { initializeFirebaseAuth } from '@sudobility/auth_lib';
+import { getAnalytics as getFirebaseAnalytics, logEvent } from '@react-native-firebase/analytics';
+import { restoreMissingPreferences, startAutoBackup } from '@/services/backup';
 
 let servicesInitialized = false;
 let analyticsService: FirebaseAnalyticsService | null = null;
 
+/**
+ * Restore unusable preference entries, then start hourly backups. Awaited
+ * before the app renders, so nothing can persist a settings change that the
+ * restore would then overwrite.
+ */
+async function startBackups(): Promise<void> {
+  try {
+    await restoreMissingPreferences();
+  } catch (error) {
+    console.error('[Backup] Restore failed:', error);
+  }
+  startAutoBackup();
+}
+
 /**
  * Initialize all services using di_rn's centralized initialization.
  *
@@ -23,6 +39,7 @@ let analyticsService: FirebaseAnalyticsService | null = null;
  * - Network service
  * - Info service (for toast notifications)
  * - Firebase Auth (via auth_lib)
+ * - Recovery of damaged preferences, then hourly incremental backups
  */
 export async function initializeAllServices(): Promise<FirebaseAnalyticsService> {
   if (servicesInitialized && analyticsService) {
@@ -35,6 +52,9 @@ export async function initializeAllServices(): Promise<FirebaseAnalyticsService>
   // 2. Initialize Firebase Auth (uses @react-native-firebase/auth)
   initializeFirebaseAuth();
 
+  // 3. Recover damaged settings / language from the backup, then keep it current
+  await startBackups();
+
   servicesInitialized = true;
   return analyticsService;
 }
@@ -45,3 +65,15 @@ export async function initializeAllServices(): Promise<FirebaseAnalyticsService>
 export function getAnalytics(): FirebaseAnalyticsService | null {
   return analyticsService;
 }
+
+/**
+ * Record an analytics event with Firebase Analytics. Fire-and-forget.
+ *
+ * @param name - Event name, e.g. `history_created`.
+ * @param params - Optional event parameters.
+ */
+export function logAnalyticsEvent(name: string, params?: Record<string, unknown>): void {
+  logEvent(getFirebaseAnalytics(), name, params).catch((error) =>
+    console.warn('[Analytics] logEvent failed:', error)
+  );
+}
@@ -1,23 +1,121 @@
 /**
  * Service initialization for starter_app_rn (Desktop: macOS / Windows)
  *
- * Desktop platforms use Firebase JS SDK which initializes lazily in AuthContext.
- * No native Firebase analytics or DI services are available on desktop.
+ * Desktop platforms talk to the Firebase Auth REST API from AuthContext.
+ * Native Firebase analytics is not available on desktop; events go through the
+ * batched {@link DesktopAnalyticsService} instead.
  */
 
+import { env } from '@/config/env';
+import { prefetchHosts } from '@/native/Network';
+import { DesktopAnalyticsService } from '@/services/analytics';
+import { startReachabilityMonitor } from '@/services/reachability';
+import { reportDiagnostics, startDiagnosticsReports } from '@/services/diagnosticsReport';
+import { startHeapTelemetry, stopHeapTelemetry } from '@/services/heapTelemetry';
+import { startFrameMonitor, stopFrameMonitor } from '@/services/frameTiming';
+import { setTimerThrottling } from '@/services/scheduler';
+import { startStallWatchdog, stopStallWatchdog } from '@/services/stallWatchdog';
+import { restoreMissingPreferences, startAutoBackup } from '@/services/backup';
+import { onVisibilityChange, startVisibilityMonitor } from '@/services/visibility';
+import { hostOf } from '@/utils/origin';
+
+/** Hosts contacted during startup and sign-in (API, Google OAuth, Firebase Auth). */
+const STARTUP_HOSTS = [
+  'oauth2.googleapis.com',
+  'accounts.google.com',
+  'identitytoolkit.googleapis.com',
+  'securetoken.googleapis.com',
+];
+
+/** Minimum timer coalescing window while the app is hidden. */
+const HIDDEN_TIMER_TOLERANCE_MS = 60 * 1000;
+
+let analyticsService: DesktopAnalyticsService | null = null;
+
+/** Start the diagnostics samplers that only matter while the app is on screen. */
+function startForegroundMonitors(): void {
+  startHeapTelemetry();
+  startStallWatchdog();
+  if (env.DEV_MODE) {
+    startFrameMonitor();
+  }
+}
+
+/**
+ * While hidden, coalesce timers onto a one-minute grid, stop the
+ * diagnostics samplers and write out the metrics collected so far; undo the
+ * first two as soon as the app is visible again.
+ */
+function applyVisibility(visible: boolean): void {
+  if (visible) {
+    setTimerThrottling(0);
+    startForegroundMonitors();
+  } else {
+    setTimerThrottling(HIDDEN_TIMER_TOLERANCE_MS);
+    stopHeapTelemetry();
+    stopFrameMonitor();
+    stopStallWatchdog();
+    // A hidden app may be closed without another report coming due.
+    reportDiagnostics().catch(() => {});
+  }
+}
+
 /**
- * Initialize all services (desktop no-op).
+ * Restore unusable preference entries, then start hourly backups. Awaited
+ * before the app renders, so nothing can persist a settings change that the
+ * restore would then overwrite.
+ */
+async function startBackups(): Promise<void> {
+  try {
+    await restoreMissingPreferences();
+  } catch (error) {
+    console.error('[Backup] Restore failed:', error);
+  }
+  startAutoBackup();
+}
+
+/**
+ * Initialize all services.
  *
- * On desktop, Firebase Auth is initialized lazily in AuthContext using the
- * Firebase JS SDK. Native analytics and DI services are not available.
+ * On desktop, Firebase Auth is initialized lazily in AuthContext. This
+ * starts the reachability and visibility monitors, heap telemetry and the
+ * stall watchdog (plus frame timing in dev mode) and the periodic
+ * diagnostics report that writes their metrics out, prefetches DNS for the
+ * hosts used at startup, recovers damaged preferences from the local backup
+ * and schedules further backups, creates the analytics service and kicks
+ * off an upload of any events persisted by a previous session.
+ */
+export async function initializeAllServices(): Promise<DesktopAnalyticsService> {
+  if (!analyticsService) {
+    startReachabilityMonitor();
+    startForegroundMonitors();
+    startDiagnosticsReports();
+    onVisibilityChange(applyVisibility);
+    startVisibilityMonitor();
+    const apiHost = hostOf(env.API_URL);
+    prefetchHosts(apiHost ? [apiHost, ...STARTUP_HOSTS] : STARTUP_HOSTS);
+
+    analyticsService = new DesktopAnalyticsService();
+    analyticsService.flush();
+    await startBackups();
+  }
+  return analyticsService;
+}
+
+/**
+ * Get the analytics service
  */
-export async function initializeAllServices(): Promise<null> {
-  return null;
+export function getAnalytics(): DesktopAnalyticsService | null {
+  return analyticsService;
 }
 
 /**
- * Get the analytics service (not available on desktop)
+ * Record an analytics event through the desktop pipeline. Events logged
+ * before {@link initializeAllServices} has run are dropped.
+ *
+ * @param name - Event name, e.g. `history_created`.
+ * @param params - Optional JSON-serialisable event parameters.
  */
-export function getAnalytics(): null {
-  return null;
+export function logAnalyticsEvent(name: string, params?: Record<string, unknown>): void {
+  analyticsService?.logEvent(name, params);
 }
@@ -0,0 +1,70 @@
+/**
+ * Tests for the history columns hook.
+ *
+ * Verifies that growing past the sliced threshold keeps the previous total
+ * (marked stale) until the sliced aggregation finishes.
+ */
+
+import React from 'react';
+import { act, create } from 'react-test-renderer';
+import type { History } from '@sudobility/superguide_types';
+import { useHistoryColumns, type HistoryColumnsState } from '../useHistoryColumns';
+
+let mockFinishSliced: (() => void) | null = null;
+
+jest.mock('@/utils/historyColumns', () => {
+  const actual = jest.requireActual('@/utils/historyColumns');
+  return {
+    ...actual,
+    buildHistoryColumnsSliced: jest.fn((histories: readonly History[]) =>
+      new Promise((resolve) => {
+        mockFinishSliced = () => resolve(actual.buildHistoryColumns(histories));
+      })),
+  };
+});
+
+function makeHistories(count: number): History[] {
+  const histories: History[] = [];
+  for (let i = 0; i < count; i++) {
+    histories.push({
+      id: `h${i}`,
+      datetime: new Date(Date.UTC(2024, 0, 1) + i * 60000).toISOString(),
+      value: 1,
+    } as History);
+  }
+  return histories;
+}
+
+describe('useHistoryColumns', () => {
+  it('should keep the previous total while a long list is aggregated', async () => {
+    const results: HistoryColumnsState[] = [];
+    function Probe({ histories }: { histories: readonly History[] }) {
+      results.push(useHistoryColumns(histories));
+      return null;
+    }
+
+    let root!: ReturnType<typeof create>;
+    act(() => {
+      root = create(<Probe histories={makeHistories(10)} />);
+    });
+    expect(results[results.length - 1]).toMatchObject({ total: 10, stale: false });
+
+    const long = makeHistories(2500);
+    act(() => {
+      root.update(<Probe histories={long} />);
+    });
+    const pending = results[results.length - 1];
+    expect(pending.total).toBe(10);
+    expect(pending.stale).toBe(true);
+    expect(results.every((result) => result.total !== 0)).toBe(true);
+
+    await act(async () => {
+      mockFinishSliced?.();
+    });
+    const done = results[results.length - 1];
+    expect(done.total).toBe(2500);
+    expect(done.stale).toBe(false);
+    expect(done.timestamps.length).toBe(long.length);
+    act(() => root.unmount());
+  });
+});
@@ -0,0 +1,82 @@
+import { useEffect, useMemo, useRef, useState } from 'react';
+import type { History } from '@sudobility/superguide_types';
+import {
+  buildHistoryColumns,
+  buildHistoryColumnsSliced,
+  type HistoryColumns,
+} from '@/utils/historyColumns';
+
+/** Lists longer than this are aggregated in time slices. */
+const SLICED_THRESHOLD = 2000;
+
+const EMPTY_COLUMNS: HistoryColumns = {
+  timestamps: new Float64Array(0),
+  values: new Float64Array(0),
+  total: 0,
+};
+
+/** {@link HistoryColumns} plus whether they were computed for an older array. */
+export interface HistoryColumnsState extends HistoryColumns {
+  /**
+   * `true` while the columns for the current array are still being computed
+   * and the previous ones are returned instead. Their `total` is a fine
+   * placeholder, but their indices may not line up with the current array.
+   */
+  stale: boolean;
+}
+
+/**
+ * Returns the derived {@link HistoryColumns} for `histories`, recomputed only
+ * when the array changes.
+ *
+ * Short lists are aggregated synchronously during render. Longer lists are
+ * aggregated in time slices after render; until that finishes the hook keeps
+ * returning the previous columns (empty on first use) with `stale` set, so
+ * totals don't flash to zero. Callers must bounds-check indices and ignore
+ * per-entry columns while `stale`.
+ *
+ * @param histories - Entries from `useHistoriesManager`.
+ * @returns Columns index-aligned with `histories` unless `stale`.
+ *
+ * @example
+ * ```tsx
+ * const { total, timestamps, stale } = useHistoryColumns(histories);
+ * ```
+ */
+export function useHistoryColumns(histories: readonly History[]): HistoryColumnsState {
+  const sliced = histories.length > SLICED_THRESHOLD;
+  const syncColumns = useMemo(
+    () => (sliced ? null : buildHistoryColumns(histories)),
+    [histories, sliced]
+  );
+  const [slicedResult, setSlicedResult] = useState<{
+    source: readonly History[];
+    columns: HistoryColumns;
+  } | null>(null);
+
+  useEffect(() => {
+    if (!sliced) return;
+    const controller = new AbortController();
+    buildHistoryColumnsSliced(histories, { signal: controller.signal })
+      .then((columns) => setSlicedResult({ source: histories, columns }))
+      .catch((error: unknown) => {
+        if (error instanceof Error && error.name === 'AbortError') return;
+        console.error('[useHistoryColumns] Aggregation failed:', error);
+      });
+    return () => controller.abort();
+  }, [histories, sliced]);
+
+  // Never hand out columns computed for a previous array as current
+  const current =
+    syncColumns ?? (slicedResult?.source === histories ? slicedResult.columns : null);
+
+  // Last columns that were current in a committed render
+  const lastColumns = useRef<HistoryColumns>(EMPTY_COLUMNS);
+  useEffect(() => {
+    if (current) lastColumns.current = current;
+  }, [current]);
+
+  const columns = current ?? lastColumns.current;
+  const stale = current === null;
+  return useMemo(() => ({ ...columns, stale }), [columns, stale]);
+}
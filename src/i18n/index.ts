@@ -58,6 +58,13 @@ const resources = {
         languageDescription: 'Select your preferred language',
         account: 'Account',
         signInDescription: 'Sync data across devices',
+        backup: 'Backup',
+        restoreBackup: 'Restore Backup',
+        restoreBackupDescription: 'Last backup: {{date}}',
+        noBackup: 'No backup yet',
+        restoreBackupConfirm: 'Replace your current settings and language with the last backup?',
+        restoreBackupDone: 'Restored {{count}} settings.',
+        restoreBackupFailed: 'Could not restore the backup.',
         about: 'About',
         version: 'Version 1.0.0',
         copyright: '2024 Sudobility',
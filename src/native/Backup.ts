@@ -0,0 +1,35 @@
+import { NativeModules, Platform } from 'react-native';
+
+interface BackupModuleInterface {
+  readBackup(): Promise<string | null>;
+  writeBackup(contents: string): Promise<boolean>;
+}
+
+const { BackupModule } = NativeModules;
+
+/**
+ * Whether backups can be kept in a native file outside AsyncStorage. When
+ * `false`, callers fall back to a separate AsyncStorage key.
+ */
+export function hasNativeBackupFile(): boolean {
+  return Platform.OS === 'windows' && !!BackupModule;
+}
+
+/**
+ * Read the native backup file.
+ *
+ * @returns Its contents, or `null` when there is none (or no native module).
+ */
+export async function readBackupFile(): Promise<string | null> {
+  if (!hasNativeBackupFile()) return null;
+  return (BackupModule as BackupModuleInterface).readBackup();
+}
+
+/**
+ * Atomically replace the native backup file. No-op without the native
+ * module.
+ */
+export async function writeBackupFile(contents: string): Promise<void> {
+  if (!hasNativeBackupFile()) return;
+  await (BackupModule as BackupModuleInterface).writeBackup(contents);
+}
@@ -0,0 +1,72 @@
+import { NativeModules, Platform } from 'react-native';
+
+/** CPU time, in milliseconds, charged to each native work class. */
+export interface ThreadCpuTimes {
+  interactive: number;
+  utility: number;
+  background: number;
+}
+
+/** `pprof` for `go tool pprof`; `folded` for flamegraph.pl / speedscope. */
+export type ProfileFormat = 'pprof' | 'folded';
+
+interface DiagnosticsModuleInterface {
+  getThreadCpuTimes(): Promise<ThreadCpuTimes>;
+  getProcessCpuTime(): Promise<number>;
+  startProfiler(intervalMs: number): Promise<boolean>;
+  stopProfiler(format: ProfileFormat): Promise<string>;
+  appendLog(text: string): void;
+}
+
+const { DiagnosticsModule } = NativeModules;
+
+export async function getThreadCpuTimes(): Promise<ThreadCpuTimes | null> {
+  if (Platform.OS === 'windows' && DiagnosticsModule) {
+    return (DiagnosticsModule as DiagnosticsModuleInterface).getThreadCpuTimes();
+  }
+  return null;
+}
+
+/** Total process CPU time (user + kernel) in milliseconds, or `null` where unsupported. */
+export async function getProcessCpuTime(): Promise<number | null> {
+  if (Platform.OS === 'windows' && DiagnosticsModule) {
+    return (DiagnosticsModule as DiagnosticsModuleInterface).getProcessCpuTime();
+  }
+  return null;
+}
+
+/**
+ * Starts sampling every native thread every `intervalMs` milliseconds
+ * (default 10). Resolves `false` if the profiler is already running or
+ * unsupported.
+ */
+export async function startProfiler(intervalMs = 10): Promise<boolean> {
+  if (Platform.OS === 'windows' && DiagnosticsModule) {
+    return (DiagnosticsModule as DiagnosticsModuleInterface).startProfiler(intervalMs);
+  }
+  return false;
+}
+
+/**
+ * Stops the profiler and resolves with the path of the written profile, or
+ * `null` where unsupported.
+ */
+export async function stopProfiler(format: ProfileFormat = 'pprof'): Promise<string | null> {
+  if (Platform.OS === 'windows' && DiagnosticsModule) {
+    return (DiagnosticsModule as DiagnosticsModuleInterface).stopProfiler(format);
+  }
+  return null;
+}
+
+/**
+ * Append `text` to the native diagnostic log
+ * (`%LOCALAPPDATA%\StarterApp\diagnostics.log`). Returns `false` where
+ * there is no diagnostic log.
+ */
+export function appendDiagnosticLog(text: string): boolean {
+  if (Platform.OS === 'windows' && DiagnosticsModule) {
+    (DiagnosticsModule as DiagnosticsModuleInterface).appendLog(text);
+    return true;
+  }
+  return false;
+}
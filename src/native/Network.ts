@@ -0,0 +1,42 @@
+import { DeviceEventEmitter, NativeModules, Platform } from 'react-native';
+
+interface NetworkModuleInterface {
+  prefetchHosts(hosts: string[]): void;
+  getReachability(): Promise<boolean>;
+}
+
+const { NetworkModule } = NativeModules;
+
+/**
+ * Warm the system DNS cache for `hosts` so the first request to each does not
+ * pay for a synchronous lookup. No-op where the native module is unavailable.
+ */
+export function prefetchHosts(hosts: string[]): void {
+  if (Platform.OS === 'windows' && NetworkModule) {
+    (NetworkModule as NetworkModuleInterface).prefetchHosts(hosts);
+  }
+}
+
+/**
+ * Resolve with whether the machine has internet access, or `null` when the
+ * platform has no native reachability monitor.
+ */
+export async function getReachability(): Promise<boolean | null> {
+  if (Platform.OS === 'windows' && NetworkModule) {
+    return (NetworkModule as NetworkModuleInterface).getReachability();
+  }
+  return null;
+}
+
+/**
+ * Subscribe to native reachability changes.
+ *
+ * @returns An unsubscribe function (a no-op where unsupported).
+ */
+export function addReachabilityListener(listener: (online: boolean) => void): () => void {
+  if (Platform.OS === 'windows' && NetworkModule) {
+    const subscription = DeviceEventEmitter.addListener('reachabilityChanged', listener);
+    return () => subscription.remove();
+  }
+  return () => {};
+}
@@ -0,0 +1,48 @@
+import { DeviceEventEmitter, NativeModules, Platform } from 'react-native';
+
+/** A JS or UI thread stall, reported once the thread recovers. */
+export interface ThreadStall {
+  thread: 'js' | 'ui';
+  durationMs: number;
+  /** Symbolized native stacks sampled while the thread was stalled. */
+  stacks: string[];
+}
+
+interface WatchdogModuleInterface {
+  start(thresholdMs: number): void;
+  stop(): void;
+}
+
+const { WatchdogModule } = NativeModules;
+
+/**
+ * Start the native stall watchdog. Returns `false` where unsupported.
+ *
+ * @param thresholdMs - How long a heartbeat may wait before the thread counts as stalled.
+ */
+export function startWatchdog(thresholdMs: number): boolean {
+  if (Platform.OS === 'windows' && WatchdogModule) {
+    (WatchdogModule as WatchdogModuleInterface).start(thresholdMs);
+    return true;
+  }
+  return false;
+}
+
+export function stopWatchdog(): void {
+  if (Platform.OS === 'windows' && WatchdogModule) {
+    (WatchdogModule as WatchdogModuleInterface).stop();
+  }
+}
+
+/**
+ * Subscribe to stalls reported by the watchdog.
+ *
+ * @returns An unsubscribe function (a no-op where unsupported).
+ */
+export function addThreadStallListener(listener: (stall: ThreadStall) => void): () => void {
+  if (Platform.OS === 'windows' && WatchdogModule) {
+    const subscription = DeviceEventEmitter.addListener('threadStalled', listener);
+    return () => subscription.remove();
+  }
+  return () => {};
+}
@@ -2,6 +2,7 @@ import { NativeModules, Platform } from 'react-native';
 
 interface WebAuthModuleInterface {
   authenticate(url: string, callbackURLScheme: string): Promise<string | null>;
+  cancelAuthentication?(): void;
   generateCodeVerifier(): Promise<string>;
   sha256(input: string): Promise<string>;
 }
@@ -21,6 +22,16 @@ export async function authenticate(
   throw new Error(`Web auth not implemented for ${Platform.OS}`);
 }
 
+/**
+ * End a pending {@link authenticate} call, which then resolves `null`.
+ * Windows only; elsewhere the system sheet has its own cancel control.
+ */
+export function cancelAuthentication(): void {
+  if (Platform.OS === 'windows' && WebAuthModule) {
+    (WebAuthModule as WebAuthModuleInterface).cancelAuthentication?.();
+  }
+}
+
 export async function generateCodeVerifier(): Promise<string> {
   if ((Platform.OS === 'macos' || Platform.OS === 'windows') && WebAuthModule) {
     return (WebAuthModule as WebAuthModuleInterface).generateCodeVerifier();
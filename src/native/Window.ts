@@ -0,0 +1,32 @@
+import { DeviceEventEmitter, NativeModules, Platform } from 'react-native';
+
+interface WindowModuleInterface {
+  isVisible(): Promise<boolean>;
+}
+
+const { WindowModule } = NativeModules;
+
+/**
+ * Resolve with whether the main window is visible (not minimized, hidden,
+ * on another virtual desktop or covered by other windows), or `null` when
+ * the platform has no native window monitor.
+ */
+export async function isWindowVisible(): Promise<boolean | null> {
+  if (Platform.OS === 'windows' && WindowModule) {
+    return (WindowModule as WindowModuleInterface).isVisible();
+  }
+  return null;
+}
+
+/**
+ * Subscribe to main-window visibility changes.
+ *
+ * @returns An unsubscribe function (a no-op where unsupported).
+ */
+export function addWindowVisibilityListener(listener: (visible: boolean) => void): () => void {
+  if (Platform.OS === 'windows' && WindowModule) {
+    const subscription = DeviceEventEmitter.addListener('windowVisibilityChanged', listener);
+    return () => subscription.remove();
+  }
+  return () => {};
+}
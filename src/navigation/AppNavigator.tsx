@@ -98,7 +98,7 @@ function MobileNavigator({ theme }: { theme: typeof lightTheme }) {
 
 export function AppNavigator() {
   const systemColorScheme = useColorScheme();
-  const { theme: userTheme } = useSettingsStore();
+  const userTheme = useSettingsStore((state) => state.theme);
   const isDark = userTheme === 'system'
     ? systemColorScheme === 'dark'
     : userTheme === 'dark';
@@ -1,4 +1,4 @@
-import React from 'react';
+import React, { memo, useCallback } from 'react';
 import { View, Text, Pressable, StyleSheet } from 'react-native';
 import {
   ClockIcon,
@@ -24,7 +24,9 @@ const tabs: { key: SidebarTab; label: string }[] = [
   { key: 'SettingsTab', label: 'Settings' },
 ];
 
-function TabIcon({ tab, focused, color }: { tab: SidebarTab; focused: boolean; color: string }) {
+// Memoised so an icon's SVG tree is only rebuilt when its own tab, focus
+// state or colour changes, not whenever the sidebar re-renders.
+const TabIcon = memo(function TabIcon({ tab, focused, color }: { tab: SidebarTab; focused: boolean; color: string }) {
   switch (tab) {
     case 'HistoriesTab':
       return focused
@@ -35,9 +37,38 @@ function TabIcon({ tab, focused, color }: { tab: SidebarTab; focused: boolean; c
         ? <Cog6ToothIconSolid color={color} size={ICON_SIZE} />
         : <Cog6ToothIcon color={color} size={ICON_SIZE} />;
   }
+});
+
+interface SidebarItemProps {
+  tab: SidebarTab;
+  label: string;
+  focused: boolean;
+  color: string;
+  focusedBackground: string;
+  onTabPress: (tab: SidebarTab) => void;
 }
 
-export function DesktopSidebar({ activeTab, onTabPress }: DesktopSidebarProps) {
+const SidebarItem = memo(function SidebarItem({
+  tab,
+  label,
+  focused,
+  color,
+  focusedBackground,
+  onTabPress,
+}: SidebarItemProps) {
+  const handlePress = useCallback(() => onTabPress(tab), [onTabPress, tab]);
+  return (
+    <Pressable
+      style={[styles.tabItem, focused && { backgroundColor: focusedBackground }]}
+      onPress={handlePress}
+    >
+      <TabIcon tab={tab} focused={focused} color={color} />
+      <Text style={[styles.tabLabel, { color }]}>{label}</Text>
+    </Pressable>
+  );
+});
+
+export const DesktopSidebar = memo(function DesktopSidebar({ activeTab, onTabPress }: DesktopSidebarProps) {
   const appColors = useAppColors();
 
   return (
@@ -49,19 +80,20 @@ export function DesktopSidebar({ activeTab, onTabPress }: DesktopSidebarProps) {
         const focused = activeTab === key;
         const color = focused ? appColors.primary : appColors.textMuted;
         return (
-          <Pressable
+          <SidebarItem
             key={key}
-            style={[styles.tabItem, focused && { backgroundColor: appColors.background }]}
-            onPress={() => onTabPress(key)}
-          >
-            <TabIcon tab={key} focused={focused} color={color} />
-            <Text style={[styles.tabLabel, { color }]}>{label}</Text>
-          </Pressable>
+            tab={key}
+            label={label}
+            focused={focused}
+            color={color}
+            focusedBackground={appColors.background}
+            onTabPress={onTabPress}
+          />
         );
       })}
     </View>
   );
-}
+});
 
 const styles = StyleSheet.create({
   sidebar: {
@@ -6,7 +6,7 @@
  * pull-to-refresh, and an "add history" modal.
  */
 
-import React, { useState, useCallback } from 'react';
+import React, { useState, useCallback, useEffect } from 'react';
 import {
   View,
   Text,
@@ -21,10 +21,13 @@ import {
 import { SafeAreaView } from 'react-native-safe-area-context';
 import { useTabBarHeight } from '@/hooks/useTabBarHeight';
 import { useTranslation } from 'react-i18next';
-import { useAuth } from '@/context/AuthContext';
 import { useApi } from '@/context/ApiContext';
 import { useHistoriesManager } from '@sudobility/superguide_lib';
 import { useAppColors } from '@/hooks/useAppColors';
+import { useHistoryColumns } from '@/hooks/useHistoryColumns';
+import { historyKey } from '@/utils/historyIndex';
+import { onReconnect } from '@/services/reachability';
+import { logAnalyticsEvent } from '@/di/initializeServices';
 import AuthModal from '@/components/AuthModal';
 import type { HistoriesListScreenProps } from '@/navigation/types';
 import type { History } from '@sudobility/superguide_types';
@@ -32,7 +35,8 @@ import type { History } from '@sudobility/superguide_types';
 export default function HistoriesScreen({ navigation }: HistoriesListScreenProps) {
   const { t } = useTranslation();
   const appColors = useAppColors();
-  const { user } = useAuth();
+  // Sign-in state comes from the same context as the token and userId the
+  // manager fetches with, so the two never disagree within a render.
   const { networkClient, baseUrl, token, userId } = useApi();
   const tabBarHeight = useTabBarHeight();
 
@@ -61,6 +65,11 @@ export default function HistoriesScreen({ navigation }: HistoriesListScreenProps
   // Pull-to-refresh state
   const [isRefreshing, setIsRefreshing] = useState(false);
 
+  // Catch up on anything missed while offline
+  useEffect(() => onReconnect(() => {
+    if (userId) refresh();
+  }), [refresh, userId]);
+
   /** Handle pull-to-refresh on the histories FlatList. */
   const handleRefresh = useCallback(async () => {
     setIsRefreshing(true);
@@ -85,6 +94,7 @@ export default function HistoriesScreen({ navigation }: HistoriesListScreenProps
         datetime: new Date().toISOString(),
         value,
       });
+      logAnalyticsEvent('history_created');
       setNewValue('');
       setShowAddModal(false);
     } catch (error: unknown) {
@@ -95,31 +105,38 @@ export default function HistoriesScreen({ navigation }: HistoriesListScreenProps
     }
   }, [newValue, createHistory]);
 
-  const userTotal = histories.reduce((sum, h) => sum + h.value, 0);
+  // Total and decoded datetimes, computed once per data change (in time
+  // slices for very long lists, keeping the previous total meanwhile).
+  const { total: userTotal, timestamps, stale } = useHistoryColumns(histories);
 
-  const renderHistoryItem = useCallback(({ item }: { item: History }) => (
-    <Pressable
-      style={[styles.historyItem, { backgroundColor: appColors.card }]}
-      onPress={() => navigation.navigate('HistoryDetail', { historyId: item.id })}
-      accessibilityRole="button"
-      accessibilityLabel={`${t('histories.value')}: ${item.value}, ${new Date(item.datetime).toLocaleDateString()}`}
-    >
-      <View style={styles.historyContent}>
-        <Text style={[styles.historyDate, { color: appColors.text }]}>
-          {new Date(item.datetime).toLocaleDateString()}
-        </Text>
-        <Text style={[styles.historyTime, { color: appColors.textMuted }]}>
-          {new Date(item.datetime).toLocaleTimeString()}
+  const renderHistoryItem = useCallback(({ item, index }: { item: History; index: number }) => {
+    const ms = !stale && index < timestamps.length ? timestamps[index] : NaN;
+    const date = new Date(Number.isNaN(ms) ? item.datetime : ms);
+    const dateLabel = date.toLocaleDateString();
+    return (
+      <Pressable
+        style={[styles.historyItem, { backgroundColor: appColors.card }]}
+        onPress={() => navigation.navigate('HistoryDetail', { historyId: item.id })}
+        accessibilityRole="button"
+        accessibilityLabel={`${t('histories.value')}: ${item.value}, ${dateLabel}`}
+      >
+        <View style={styles.historyContent}>
+          <Text style={[styles.historyDate, { color: appColors.text }]}>
+            {dateLabel}
+          </Text>
+          <Text style={[styles.historyTime, { color: appColors.textMuted }]}>
+            {date.toLocaleTimeString()}
+          </Text>
+        </View>
+        <Text style={[styles.historyValue, { color: appColors.primary }]}>
+          {item.value}
         </Text>
-      </View>
-      <Text style={[styles.historyValue, { color: appColors.primary }]}>
-        {item.value}
-      </Text>
-    </Pressable>
-  ), [appColors, navigation, t]);
+      </Pressable>
+    );
+  }, [appColors, navigation, t, timestamps, stale]);
 
   // Not logged in - show sign-in prompt
-  if (!user) {
+  if (!userId) {
     return (
       <SafeAreaView style={[styles.container, { backgroundColor: appColors.background }]} edges={['left', 'right']}>
         <View style={styles.centered}>
@@ -190,12 +207,19 @@ export default function HistoriesScreen({ navigation }: HistoriesListScreenProps
       ) : (
         <FlatList
           data={histories}
-          keyExtractor={(item) => item.id}
+          keyExtractor={historyKey}
           renderItem={renderHistoryItem}
           contentContainerStyle={[styles.listContent, { paddingBottom: tabBarHeight + 16 }]}
           ItemSeparatorComponent={ListSeparator}
           onRefresh={handleRefresh}
           refreshing={isRefreshing}
+          // Long histories are virtualized: render the first screen, add
+          // rows in batches while scrolling, keep ~5 screens mounted and
+          // unmount rows scrolled far away
+          initialNumToRender={12}
+          maxToRenderPerBatch={12}
+          windowSize={5}
+          removeClippedSubviews
         />
       )}
 
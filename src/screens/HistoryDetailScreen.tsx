@@ -19,6 +19,8 @@ import { useTranslation } from 'react-i18next';
 import { useApi } from '@/context/ApiContext';
 import { useHistoriesManager } from '@sudobility/superguide_lib';
 import { useAppColors } from '@/hooks/useAppColors';
+import { toDate } from '@/utils/timestamps';
+import { findHistory } from '@/utils/historyIndex';
 import type { HistoryDetailScreenProps } from '@/navigation/types';
 
 export default function HistoryDetailScreen({ route, navigation }: HistoryDetailScreenProps) {
@@ -38,7 +40,7 @@ export default function HistoryDetailScreen({ route, navigation }: HistoryDetail
     token,
   });
 
-  const history = histories.find(h => h.id === historyId);
+  const history = findHistory(histories, historyId);
 
   /** Confirm and execute deletion of the current history entry. */
   const handleDelete = useCallback(() => {
@@ -96,7 +98,7 @@ export default function HistoryDetailScreen({ route, navigation }: HistoryDetail
               {t('histories.datetime')}
             </Text>
             <Text style={[styles.fieldValue, { color: appColors.text }]}>
-              {new Date(history.datetime).toLocaleString()}
+              {toDate(history.datetime).toLocaleString()}
             </Text>
           </View>
 
@@ -119,7 +121,7 @@ export default function HistoryDetailScreen({ route, navigation }: HistoryDetail
                   {t('histories.createdAt')}
                 </Text>
                 <Text style={[styles.fieldValue, { color: appColors.text }]}>
-                  {new Date(history.created_at).toLocaleString()}
+                  {toDate(history.created_at).toLocaleString()}
                 </Text>
               </View>
             </>
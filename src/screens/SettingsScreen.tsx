@@ -2,10 +2,11 @@
  * SettingsScreen - App settings and preferences
  *
  * Displays appearance settings (theme), account info with sign-in/sign-out,
- * and about section. Uses the shared AuthModal for authentication flows.
+ * restore from the local backup, and an about section. Uses the shared
+ * AuthModal for authentication flows.
  */
 
-import React, { useCallback, useState } from 'react';
+import React, { useCallback, useEffect, useState } from 'react';
 import {
   View,
   Text,
@@ -19,12 +20,14 @@ import { SafeAreaView } from 'react-native-safe-area-context';
 import { useTabBarHeight } from '@/hooks/useTabBarHeight';
 import { useTranslation } from 'react-i18next';
 import i18n from '@/i18n';
-import { useAuth } from '@/context/AuthContext';
+import { useAuthSelector } from '@/stores/authStore';
+import { logAnalyticsEvent } from '@/di/initializeServices';
 import { useSettingsStore, type ThemeMode } from '@/stores/settingsStore';
 import { useAppColors } from '@/hooks/useAppColors';
 import { changeLanguage } from '@/i18n';
 import { SUPPORTED_LANGUAGES } from '@/config/constants';
 import AuthModal from '@/components/AuthModal';
+import { getLastBackupTime, restoreBackup } from '@/services/backup';
 import type { SettingsScreenProps } from '@/navigation/types';
 
 /** Display names for supported languages (in their native script). */
@@ -57,14 +60,26 @@ const themes: { value: ThemeMode; label: string }[] = [
 export default function SettingsScreen(_props: SettingsScreenProps) {
   const { t } = useTranslation();
   const appColors = useAppColors();
-  const { user, isLoading: authLoading, signOut } = useAuth();
-  const { theme, setTheme } = useSettingsStore();
+  const user = useAuthSelector((auth) => auth.user);
+  const authLoading = useAuthSelector((auth) => auth.isLoading);
+  const signOut = useAuthSelector((auth) => auth.signOut);
+  const theme = useSettingsStore((state) => state.theme);
+  const setTheme = useSettingsStore((state) => state.setTheme);
 
   const tabBarHeight = useTabBarHeight();
 
   // Auth modal state
   const [showAuthModal, setShowAuthModal] = useState(false);
 
+  // Epoch ms of the last backup; null when there is none (or not loaded yet)
+  const [lastBackup, setLastBackup] = useState<number | null>(null);
+
+  useEffect(() => {
+    getLastBackupTime()
+      .then(setLastBackup)
+      .catch(() => {});
+  }, []);
+
   /** Show an alert to pick a theme mode. */
   const handleThemeChange = useCallback(() => {
     const currentIndex = themes.findIndex(th => th.value === theme);
@@ -111,6 +126,7 @@ export default function SettingsScreen(_props: SettingsScreenProps) {
           onPress: async () => {
             try {
               await signOut();
+              logAnalyticsEvent('logout');
             } catch (error) {
               console.error('Sign out error:', error);
             }
@@ -120,6 +136,30 @@ export default function SettingsScreen(_props: SettingsScreenProps) {
     );
   }, [signOut, t]);
 
+  /** Confirm and restore settings and language from the last backup. */
+  const handleRestoreBackup = useCallback(() => {
+    Alert.alert(
+      t('settings.restoreBackup'),
+      t('settings.restoreBackupConfirm'),
+      [
+        { text: t('common.cancel'), style: 'cancel' },
+        {
+          text: t('settings.restoreBackup'),
+          style: 'destructive',
+          onPress: async () => {
+            try {
+              const count = await restoreBackup();
+              Alert.alert(t('settings.restoreBackup'), t('settings.restoreBackupDone', { count }));
+            } catch (error) {
+              console.error('[Backup] Restore failed:', error);
+              Alert.alert(t('common.error'), t('settings.restoreBackupFailed'));
+            }
+          },
+        },
+      ]
+    );
+  }, [t]);
+
   const currentTheme = themes.find(th => th.value === theme)?.label ?? 'System';
 
   return (
@@ -220,6 +260,34 @@ export default function SettingsScreen(_props: SettingsScreenProps) {
           </View>
         </View>
 
+        {/* Backup Section */}
+        <View style={styles.section}>
+          <Text style={[styles.sectionTitle, { color: appColors.textMuted }]}>
+            {t('settings.backup')}
+          </Text>
+          <View style={[styles.group, { backgroundColor: appColors.card }]}>
+            <Pressable
+              style={styles.settingRow}
+              onPress={handleRestoreBackup}
+              disabled={lastBackup === null}
+              accessibilityRole="button"
+              accessibilityLabel={t('settings.restoreBackup')}
+              accessibilityState={{ disabled: lastBackup === null }}
+            >
+              <View style={styles.settingContent}>
+                <Text style={[styles.settingLabel, { color: lastBackup === null ? appColors.textMuted : appColors.text }]}>
+                  {t('settings.restoreBackup')}
+                </Text>
+                <Text style={[styles.settingDescription, { color: appColors.textMuted }]}>
+                  {lastBackup === null
+                    ? t('settings.noBackup')
+                    : t('settings.restoreBackupDescription', { date: new Date(lastBackup).toLocaleString() })}
+                </Text>
+              </View>
+            </Pressable>
+          </View>
+        </View>
+
         {/* About Section */}
         <View style={styles.section}>
           <Text style={[styles.sectionTitle, { color: appColors.textMuted }]}>
@@ -0,0 +1,81 @@
+/**
+ * Tests for the desktop analytics pipeline.
+ *
+ * Verifies that a failed upload's backoff is not cut short by events logged
+ * meanwhile, and that batches the collector rejects are dropped.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { STORAGE_KEYS } from '@/config/constants';
+import { DesktopAnalyticsService } from '../analytics';
+
+interface MockTimer {
+  delayMs: number;
+  cancelled: boolean;
+}
+
+const mockTimers: MockTimer[] = [];
+
+jest.mock('@react-native-async-storage/async-storage', () =>
+  require('@react-native-async-storage/async-storage/jest/async-storage-mock')
+);
+jest.mock('@/config/env', () => ({ env: { ANALYTICS_URL: 'http://collector.test/events' } }));
+jest.mock('@/services/reachability', () => ({ isOnline: () => true, onReconnect: () => () => {} }));
+jest.mock('@/services/scheduler', () => ({
+  scheduleTimeout: (_callback: () => void, delayMs: number) => {
+    const timer = { delayMs, cancelled: false };
+    mockTimers.push(timer);
+    return { cancel: () => { timer.cancelled = true; } };
+  },
+}));
+
+function activeTimers(): MockTimer[] {
+  return mockTimers.filter((timer) => !timer.cancelled);
+}
+
+describe('DesktopAnalyticsService', () => {
+  beforeEach(async () => {
+    mockTimers.length = 0;
+    await AsyncStorage.clear();
+    jest.spyOn(console, 'warn').mockImplementation(() => {});
+  });
+
+  afterEach(() => {
+    jest.restoreAllMocks();
+  });
+
+  it('should keep the backoff when events are logged during a failing upload', async () => {
+    let respond!: (response: Response) => void;
+    global.fetch = jest.fn(() => new Promise<Response>((resolve) => { respond = resolve; })) as unknown as typeof fetch;
+
+    const service = new DesktopAnalyticsService();
+    service.logEvent('first');
+    const flushing = service.flush();
+    // Wait for the upload to start, then log while it is in flight
+    while (!respond) await new Promise((resolve) => setTimeout(resolve, 0));
+    service.logEvent('during_upload');
+    respond({ ok: false, status: 503 } as Response);
+    await flushing;
+
+    const timers = activeTimers();
+    expect(timers).toHaveLength(1);
+    expect(timers[0].delayMs).toBe(60 * 1000);
+
+    // A flush requested during the backoff persists but does not upload
+    await service.flush();
+    expect(global.fetch).toHaveBeenCalledTimes(1);
+    expect(activeTimers()[0].delayMs).toBeGreaterThan(30 * 1000);
+  });
+
+  it('should drop batches the collector rejects', async () => {
+    global.fetch = jest.fn(() => Promise.resolve({ ok: false, status: 400 } as Response)) as unknown as typeof fetch;
+
+    const service = new DesktopAnalyticsService();
+    service.logEvent('malformed');
+    await service.flush();
+
+    expect(global.fetch).toHaveBeenCalledTimes(1);
+    expect(JSON.parse((await AsyncStorage.getItem(STORAGE_KEYS.ANALYTICS_QUEUE)) as string)).toEqual([]);
+    expect(activeTimers()).toHaveLength(0);
+  });
+});
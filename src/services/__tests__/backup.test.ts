@@ -0,0 +1,91 @@
+/**
+ * Tests for incremental preference backups.
+ *
+ * Verifies that backups are only written when a value changed, that deleted
+ * entries are dropped from the backup, and that restore copies the backup
+ * back (everything, or only missing / unreadable entries at startup).
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { STORAGE_KEYS } from '@/config/constants';
+import { loadStoredLanguagePreference } from '@/i18n';
+import { createBackup, restoreBackup, restoreMissingPreferences, getLastBackupTime } from '../backup';
+
+jest.mock('@react-native-async-storage/async-storage', () =>
+  require('@react-native-async-storage/async-storage/jest/async-storage-mock')
+);
+
+jest.mock('@/stores/settingsStore', () => ({
+  useSettingsStore: { persist: { rehydrate: jest.fn(() => Promise.resolve()) } },
+}));
+
+jest.mock('@/i18n', () => ({ loadStoredLanguagePreference: jest.fn(() => Promise.resolve()) }));
+
+jest.mock('@/native/Backup', () => ({
+  hasNativeBackupFile: () => false,
+  readBackupFile: jest.fn(),
+  writeBackupFile: jest.fn(),
+}));
+
+async function backedUpEntries(): Promise<Record<string, string>> {
+  return JSON.parse((await AsyncStorage.getItem(STORAGE_KEYS.BACKUP)) as string).entries;
+}
+
+describe('backup', () => {
+  beforeEach(async () => {
+    await AsyncStorage.clear();
+    await AsyncStorage.setItem('starter-settings', '{"state":{"theme":"dark"},"version":0}');
+    await AsyncStorage.setItem(STORAGE_KEYS.LANGUAGE, 'de');
+    jest.mocked(loadStoredLanguagePreference).mockClear();
+  });
+
+  it('should copy every entry on the first backup', async () => {
+    expect(await getLastBackupTime()).toBeNull();
+    expect(await createBackup()).toEqual({ written: 2, unchanged: 0, removed: 0 });
+    expect((await backedUpEntries())[STORAGE_KEYS.LANGUAGE]).toBe('de');
+    expect(await getLastBackupTime()).not.toBeNull();
+  });
+
+  it('should only count entries that changed and skip the write when none did', async () => {
+    await createBackup();
+    await AsyncStorage.setItem(STORAGE_KEYS.LANGUAGE, 'fr');
+    expect(await createBackup()).toEqual({ written: 1, unchanged: 1, removed: 0 });
+
+    const setItem = jest.spyOn(AsyncStorage, 'setItem');
+    expect(await createBackup()).toEqual({ written: 0, unchanged: 2, removed: 0 });
+    expect(setItem).not.toHaveBeenCalled();
+    setItem.mockRestore();
+  });
+
+  it('should drop entries whose source was removed', async () => {
+    await createBackup();
+    await AsyncStorage.removeItem(STORAGE_KEYS.LANGUAGE);
+    expect(await createBackup()).toEqual({ written: 0, unchanged: 1, removed: 1 });
+    expect((await backedUpEntries())[STORAGE_KEYS.LANGUAGE]).toBeUndefined();
+  });
+
+  it('should restore backed-up entries and re-apply the language', async () => {
+    await createBackup();
+    await AsyncStorage.setItem(STORAGE_KEYS.LANGUAGE, 'ja');
+    await AsyncStorage.removeItem('starter-settings');
+    expect(await restoreBackup()).toBe(2);
+    expect(await AsyncStorage.getItem(STORAGE_KEYS.LANGUAGE)).toBe('de');
+    expect(await AsyncStorage.getItem('starter-settings')).toContain('dark');
+    expect(loadStoredLanguagePreference).toHaveBeenCalled();
+  });
+
+  it('should only restore missing or unreadable entries at startup', async () => {
+    await createBackup();
+    await AsyncStorage.setItem(STORAGE_KEYS.LANGUAGE, 'ja');
+    await AsyncStorage.setItem('starter-settings', '{"state":');
+    expect(await restoreMissingPreferences()).toBe(1);
+    expect(await AsyncStorage.getItem('starter-settings')).toContain('dark');
+    expect(await AsyncStorage.getItem(STORAGE_KEYS.LANGUAGE)).toBe('ja');
+    expect(loadStoredLanguagePreference).not.toHaveBeenCalled();
+  });
+
+  it('should restore nothing without a backup', async () => {
+    await AsyncStorage.removeItem('starter-settings');
+    expect(await restoreMissingPreferences()).toBe(0);
+  });
+});
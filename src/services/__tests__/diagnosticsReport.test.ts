@@ -0,0 +1,96 @@
+/**
+ * Tests for the periodic diagnostics report.
+ *
+ * Verifies that a report carries the recorded metrics, long frames and
+ * native CPU times to the diagnostic log and resets them, and that nothing
+ * is written when nothing was recorded.
+ */
+
+import { appendDiagnosticLog, getThreadCpuTimes } from '@/native/Diagnostics';
+import { getMetricsSnapshot, recordHistogram, resetMetrics, setGauge } from '@/services/metrics';
+import { reportDiagnostics, writeDiagnosticsReport } from '../diagnosticsReport';
+
+jest.mock('@/config/env', () => ({ env: { DEV_MODE: false } }));
+jest.mock('@/native/Diagnostics', () => ({
+  appendDiagnosticLog: jest.fn(() => true),
+  getThreadCpuTimes: jest.fn(async () => null),
+}));
+jest.mock('@/services/frameTiming', () => {
+  const frames: unknown[] = [];
+  return {
+    mockFrames: frames,
+    getLongFrames: () => [...frames],
+    clearLongFrames: () => { frames.length = 0; },
+  };
+});
+
+const mockFrames: unknown[] = jest.requireMock('@/services/frameTiming').mockFrames;
+
+describe('writeDiagnosticsReport', () => {
+  beforeEach(() => {
+    resetMetrics();
+    mockFrames.length = 0;
+    jest.mocked(appendDiagnosticLog).mockClear();
+  });
+
+  it('should write the metrics as one JSON line and reset them', () => {
+    recordHistogram('js.stall', 800);
+    setGauge('js.heap.size', 1024);
+
+    const report = writeDiagnosticsReport();
+
+    expect(appendDiagnosticLog).toHaveBeenCalledTimes(1);
+    const line = jest.mocked(appendDiagnosticLog).mock.calls[0][0];
+    expect(line).not.toContain('\n');
+    expect(JSON.parse(line)).toEqual(JSON.parse(JSON.stringify(report)));
+    expect(report?.metrics.histograms['js.stall'].max).toBe(800);
+    expect(report?.metrics.gauges['js.heap.size']).toBe(1024);
+    expect(getMetricsSnapshot()).toEqual({ gauges: {}, histograms: {} });
+  });
+
+  it('should report long frames once', () => {
+    mockFrames.push({ endedAt: 1, durationMs: 120, gcs: 1 });
+
+    expect(writeDiagnosticsReport()?.longFrames).toEqual([{ endedAt: 1, durationMs: 120, gcs: 1 }]);
+    expect(writeDiagnosticsReport()).toBeNull();
+  });
+
+  it('should write nothing when no metric was recorded', () => {
+    expect(writeDiagnosticsReport()).toBeNull();
+    expect(appendDiagnosticLog).not.toHaveBeenCalled();
+  });
+
+  it('should keep the metrics when there is no diagnostic log', () => {
+    jest.mocked(appendDiagnosticLog).mockReturnValueOnce(false);
+    recordHistogram('ui.frame', 16);
+
+    expect(writeDiagnosticsReport()).toBeNull();
+    expect(getMetricsSnapshot().histograms['ui.frame'].count).toBe(1);
+  });
+});
+
+describe('reportDiagnostics', () => {
+  beforeEach(() => {
+    resetMetrics();
+    mockFrames.length = 0;
+  });
+
+  it('should include the native CPU time per work class', async () => {
+    jest.mocked(getThreadCpuTimes).mockResolvedValueOnce({ interactive: 40, utility: 25, background: 310 });
+
+    const report = await reportDiagnostics();
+
+    expect(report?.metrics.gauges).toEqual({
+      'native.cpu.interactive': 40,
+      'native.cpu.utility': 25,
+      'native.cpu.background': 310,
+    });
+  });
+
+  it('should still report when the CPU times are unavailable', async () => {
+    jest.mocked(getThreadCpuTimes).mockRejectedValueOnce(new Error('unavailable'));
+    recordHistogram('ui.frame', 16);
+
+    expect((await reportDiagnostics())?.metrics.histograms['ui.frame'].count).toBe(1);
+  });
+});
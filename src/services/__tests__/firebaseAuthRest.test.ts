@@ -0,0 +1,251 @@
+/**
+ * Tests for the Firebase Auth REST client.
+ *
+ * Runs the client against an in-process stand-in for the Identity Toolkit
+ * and Secure Token endpoints (a `fetch` mock) and checks sign-in, token
+ * refresh, error mapping, session persistence (including the migration of
+ * a Firebase JS SDK session), and sign-in / sign-out racing an in-flight
+ * refresh or restore.
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { STORAGE_KEYS } from '@/config/constants';
+import { FirebaseAuthRestClient, type AuthSession } from '../firebaseAuthRest';
+
+jest.mock('@react-native-async-storage/async-storage', () =>
+  require('@react-native-async-storage/async-storage/jest/async-storage-mock')
+);
+
+interface StandInAccount {
+  uid: string;
+  password: string;
+}
+
+/** Minimal Identity Toolkit / Secure Token server. */
+function createStandInServer() {
+  const accounts = new Map<string, StandInAccount>([['ada@example.com', { uid: 'u1', password: 'hunter22' }]]);
+  const refreshTokens = new Map<string, string>();
+  let issued = 0;
+  const requests: string[] = [];
+
+  const json = (status: number, body: unknown) =>
+    Promise.resolve({ ok: status < 400, status, json: () => Promise.resolve(body) } as Response);
+
+  const issue = (uid: string, email: string) => {
+    issued++;
+    const refreshToken = `refresh-${issued}`;
+    refreshTokens.set(refreshToken, uid);
+    return { localId: uid, email, idToken: `id-${issued}`, refreshToken, expiresIn: '3600' };
+  };
+
+  const fetchMock = jest.fn((url: string, init: RequestInit) => {
+    const method = url.split('?')[0].split('/').pop() ?? '';
+    requests.push(method);
+    if (method === 'token') {
+      const params = new URLSearchParams(init.body as string);
+      const uid = refreshTokens.get(params.get('refresh_token') ?? '');
+      if (!uid) return json(400, { error: { code: 400, message: 'INVALID_REFRESH_TOKEN' } });
+      issued++;
+      refreshTokens.set(`refresh-${issued}`, uid);
+      return json(200, { id_token: `id-${issued}`, refresh_token: `refresh-${issued}`, expires_in: '3600', user_id: uid });
+    }
+
+    const body = JSON.parse(init.body as string);
+    switch (method) {
+      case 'accounts:signInWithPassword': {
+        const account = accounts.get(body.email);
+        if (!account) return json(400, { error: { code: 400, message: 'EMAIL_NOT_FOUND' } });
+        if (account.password !== body.password) {
+          return json(400, { error: { code: 400, message: 'INVALID_PASSWORD' } });
+        }
+        return json(200, issue(account.uid, body.email));
+      }
+      case 'accounts:signUp': {
+        if (accounts.has(body.email)) return json(400, { error: { code: 400, message: 'EMAIL_EXISTS' } });
+        if (body.password.length < 6) {
+          return json(400, { error: { code: 400, message: 'WEAK_PASSWORD : Password should be at least 6 characters' } });
+        }
+        const uid = `u${accounts.size + 1}`;
+        accounts.set(body.email, { uid, password: body.password });
+        return json(200, issue(uid, body.email));
+      }
+      case 'accounts:sendOobCode':
+        return json(200, { email: body.email });
+      default:
+        return json(404, { error: { code: 404, message: 'NOT_FOUND' } });
+    }
+  });
+
+  return { fetchMock, requests, refreshTokens };
+}
+
+describe('FirebaseAuthRestClient', () => {
+  let server: ReturnType<typeof createStandInServer>;
+  let client: FirebaseAuthRestClient;
+
+  beforeEach(async () => {
+    await AsyncStorage.clear();
+    server = createStandInServer();
+    global.fetch = server.fetchMock as unknown as typeof fetch;
+    client = new FirebaseAuthRestClient({ apiKey: 'test-key' });
+  });
+
+  it('should sign in with email and password and persist the session', async () => {
+    const listener = jest.fn();
+    client.onSessionChanged(listener);
+
+    const session = await client.signInWithPassword('ada@example.com', 'hunter22');
+
+    expect(session).toMatchObject({ uid: 'u1', email: 'ada@example.com', idToken: 'id-1' });
+    expect(listener).toHaveBeenCalledWith(session);
+    const stored = JSON.parse((await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION)) as string);
+    expect(stored.refreshToken).toBe('refresh-1');
+  });
+
+  it('should map REST errors to SDK-style codes', async () => {
+    await expect(client.signInWithPassword('ada@example.com', 'wrong')).rejects.toMatchObject({
+      code: 'auth/wrong-password',
+    });
+    await expect(client.signUp('ada@example.com', 'whatever')).rejects.toMatchObject({
+      code: 'auth/email-already-in-use',
+    });
+    await expect(client.signUp('new@example.com', '123')).rejects.toMatchObject({
+      code: 'auth/weak-password',
+    });
+  });
+
+  it('should return the cached token until it nears expiry', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    expect(await client.getIdToken()).toBe('id-1');
+    expect(server.requests).not.toContain('token');
+
+    const session = client.currentSession as AuthSession;
+    session.expiresAt = Date.now() + 60 * 1000;
+    expect(await client.getIdToken()).toBe('id-2');
+    expect(client.currentSession?.refreshToken).toBe('refresh-2');
+  });
+
+  it('should share one refresh between concurrent callers', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    const tokens = await Promise.all([client.getIdToken(true), client.getIdToken(true)]);
+    expect(tokens).toEqual(['id-2', 'id-2']);
+    expect(server.requests.filter((m) => m === 'token')).toHaveLength(1);
+  });
+
+  it('should sign out when the refresh token is revoked', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    server.refreshTokens.clear();
+    const listener = jest.fn();
+    client.onSessionChanged(listener);
+
+    await expect(client.getIdToken(true)).rejects.toMatchObject({ code: 'auth/invalid-refresh-token' });
+    expect(client.currentSession).toBeNull();
+    expect(listener).toHaveBeenCalledWith(null);
+    expect(await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION)).toBeNull();
+  });
+
+  it('should restore a persisted session in a new client', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+
+    const restoredClient = new FirebaseAuthRestClient({ apiKey: 'test-key' });
+    const restored = await restoredClient.restore();
+    expect(restored?.uid).toBe('u1');
+    expect(await restoredClient.getIdToken()).toBe('id-1');
+  });
+
+  it('should migrate a session persisted by the Firebase JS SDK once', async () => {
+    const legacyKey = 'firebase:authUser:test-key:[DEFAULT]';
+    server.refreshTokens.set('sdk-refresh', 'u1');
+    await AsyncStorage.setItem(legacyKey, JSON.stringify({
+      uid: 'u1',
+      email: 'ada@example.com',
+      displayName: 'Ada',
+      photoURL: null,
+      isAnonymous: false,
+      stsTokenManager: { refreshToken: 'sdk-refresh', accessToken: 'sdk-id', expirationTime: Date.now() + 3600 * 1000 },
+      appName: '[DEFAULT]',
+    }));
+
+    const restored = await client.restore();
+
+    expect(restored).toMatchObject({ uid: 'u1', email: 'ada@example.com', displayName: 'Ada', idToken: 'sdk-id' });
+    expect(await client.getIdToken()).toBe('sdk-id');
+    expect(await AsyncStorage.getItem(legacyKey)).toBeNull();
+    const stored = JSON.parse((await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION)) as string);
+    expect(stored.refreshToken).toBe('sdk-refresh');
+    // The SDK's refresh token keeps working with the REST endpoint.
+    expect(await client.getIdToken(true)).toBe('id-1');
+  });
+
+  it('should ignore an SDK record without a refresh token', async () => {
+    await AsyncStorage.setItem('firebase:authUser:test-key:[DEFAULT]', JSON.stringify({ uid: 'u1' }));
+    expect(await client.restore()).toBeNull();
+  });
+
+  /** Hold the next `fetch` until the returned function is called. */
+  function holdNextRequest(): () => void {
+    let release!: () => void;
+    const gate = new Promise<void>((resolve) => {
+      release = resolve;
+    });
+    const serve = server.fetchMock.getMockImplementation()!;
+    server.fetchMock.mockImplementationOnce(async (url: string, init: RequestInit) => {
+      await gate;
+      return serve(url, init);
+    });
+    return release;
+  }
+
+  it('should drop a refreshed token when the user signs out mid-refresh', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    const release = holdNextRequest();
+
+    const pending = client.getIdToken(true);
+    await client.signOut();
+    release();
+
+    expect(await pending).toBeNull();
+    expect(client.currentSession).toBeNull();
+    expect(await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION)).toBeNull();
+  });
+
+  it('should not hand out the previous user\'s token after an account switch mid-refresh', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    const release = holdNextRequest();
+
+    const pending = client.getIdToken(true);
+    await client.signOut();
+    const other = await client.signUp('grace@example.com', 'cobol59');
+    release();
+
+    expect(await pending).toBeNull();
+    expect(client.currentSession?.uid).toBe(other.uid);
+    expect(await client.getIdToken()).toBe(other.idToken);
+  });
+
+  it('should not let a slow restore overwrite a sign-in that finished first', async () => {
+    await client.signInWithPassword('ada@example.com', 'hunter22');
+    const stored = await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION);
+
+    let release!: () => void;
+    const gate = new Promise<void>((resolve) => {
+      release = resolve;
+    });
+    jest.spyOn(AsyncStorage, 'getItem').mockImplementationOnce(async () => {
+      await gate;
+      return stored;
+    });
+
+    const restoredClient = new FirebaseAuthRestClient({ apiKey: 'test-key' });
+    const listener = jest.fn();
+    restoredClient.onSessionChanged(listener);
+    const restoring = restoredClient.restore();
+    const signedIn = await restoredClient.signUp('grace@example.com', 'cobol59');
+    release();
+
+    expect((await restoring)?.uid).toBe(signedIn.uid);
+    expect(restoredClient.currentSession?.uid).toBe(signedIn.uid);
+    expect(listener).toHaveBeenCalledTimes(1);
+    expect(listener).toHaveBeenCalledWith(signedIn);
+  });
+});
@@ -0,0 +1,103 @@
+/**
+ * Tests for the coalescing timer scheduler.
+ *
+ * Verifies one-shot and repeating timers, cancellation, that timers with a
+ * tolerance share an existing wake-up instead of arming their own, and
+ * throttling while the app is hidden.
+ */
+
+describe('scheduler', () => {
+  let scheduleTimeout: typeof import('../scheduler').scheduleTimeout;
+  let scheduleInterval: typeof import('../scheduler').scheduleInterval;
+  let setTimerThrottling: typeof import('../scheduler').setTimerThrottling;
+  let getSchedulerStats: typeof import('../scheduler').getSchedulerStats;
+
+  beforeEach(() => {
+    jest.useFakeTimers();
+    jest.setSystemTime(0);
+    // Fresh module state (slot table and armed timeout) for every test
+    jest.resetModules();
+    ({ scheduleTimeout, scheduleInterval, setTimerThrottling, getSchedulerStats } = require('../scheduler'));
+  });
+
+  afterEach(() => {
+    jest.clearAllTimers();
+    jest.useRealTimers();
+  });
+
+  it('should run a one-shot timer once after its delay', () => {
+    const task = jest.fn();
+    scheduleTimeout(task, 5000);
+    jest.advanceTimersByTime(4999);
+    expect(task).not.toHaveBeenCalled();
+    jest.advanceTimersByTime(1);
+    expect(task).toHaveBeenCalledTimes(1);
+    jest.advanceTimersByTime(60000);
+    expect(task).toHaveBeenCalledTimes(1);
+  });
+
+  it('should repeat an interval timer until cancelled', () => {
+    const task = jest.fn();
+    const handle = scheduleInterval(task, 2000);
+    jest.advanceTimersByTime(6000);
+    expect(task).toHaveBeenCalledTimes(3);
+    handle.cancel();
+    jest.advanceTimersByTime(6000);
+    expect(task).toHaveBeenCalledTimes(3);
+  });
+
+  it('should not run a cancelled timer', () => {
+    const task = jest.fn();
+    scheduleTimeout(task, 1000).cancel();
+    jest.advanceTimersByTime(5000);
+    expect(task).not.toHaveBeenCalled();
+  });
+
+  it('should coalesce a tolerant timer into an existing later wake-up', () => {
+    const order: string[] = [];
+    scheduleTimeout(() => order.push('late'), 10000);
+    scheduleTimeout(() => order.push('tolerant'), 7000, { toleranceMs: 5000 });
+    jest.advanceTimersByTime(9999);
+    expect(order).toEqual([]);
+    jest.advanceTimersByTime(1);
+    expect(order).toEqual(['late', 'tolerant']);
+  });
+
+  it('should keep firing other timers when a task throws', () => {
+    const error = jest.spyOn(console, 'error').mockImplementation(() => {});
+    const task = jest.fn();
+    scheduleTimeout(() => {
+      throw new Error('boom');
+    }, 1000);
+    scheduleTimeout(task, 1000);
+    jest.advanceTimersByTime(1000);
+    expect(task).toHaveBeenCalledTimes(1);
+    expect(error).toHaveBeenCalled();
+    error.mockRestore();
+  });
+
+  it('should collapse wake-ups onto a coarse grid while throttled', () => {
+    setTimerThrottling(60000);
+    const a = jest.fn();
+    const b = jest.fn();
+    scheduleTimeout(a, 5000);
+    scheduleTimeout(b, 20000);
+    jest.advanceTimersByTime(59999);
+    expect(a).not.toHaveBeenCalled();
+    jest.advanceTimersByTime(1);
+    expect(a).toHaveBeenCalledTimes(1);
+    expect(b).toHaveBeenCalledTimes(1);
+    expect(getSchedulerStats().wakeups).toBe(1);
+  });
+
+  it('should run overdue timers as soon as throttling is cleared', () => {
+    setTimerThrottling(60000);
+    const task = jest.fn();
+    scheduleTimeout(task, 5000);
+    jest.advanceTimersByTime(10000);
+    expect(task).not.toHaveBeenCalled();
+    setTimerThrottling(0);
+    jest.advanceTimersByTime(0);
+    expect(task).toHaveBeenCalledTimes(1);
+  });
+});
@@ -0,0 +1,119 @@
+/**
+ * Tests for client request tracing.
+ *
+ * Verifies `traceparent` / `tracestate` propagation, that requests join the
+ * active span's trace and otherwise start their own, and that spans are
+ * exported as OTLP JSON exactly once.
+ */
+
+jest.mock('@/config/env', () => ({
+  env: { TRACES_URL: 'http://collector.test/v1/traces', TRACE_STATE: 'vendor=abc' },
+}));
+jest.mock('@/services/reachability', () => ({ isOnline: () => true }));
+
+import {
+  endRequestSpan,
+  exportSpans,
+  getActiveSpan,
+  getSessionId,
+  startActiveSpan,
+  startRequestSpan,
+  toTraceparent,
+} from '../tracing';
+
+describe('tracing', () => {
+  it('should format a W3C traceparent', () => {
+    const { span, headers } = startRequestSpan('GET', 'http://api.test/histories?limit=5');
+    expect(headers.traceparent).toMatch(/^00-[0-9a-f]{32}-[0-9a-f]{16}-01$/);
+    expect(headers.traceparent).toBe(toTraceparent(span));
+  });
+
+  it('should start a new trace for each request', () => {
+    const first = startRequestSpan('GET', 'http://api.test/histories').span;
+    const second = startRequestSpan('GET', 'http://api.test/histories').span;
+    expect(first.traceId).not.toBe(second.traceId);
+  });
+
+  it('should forward the configured tracestate', () => {
+    expect(startRequestSpan('GET', 'http://api.test/histories').headers.tracestate).toBe('vendor=abc');
+  });
+
+  it('should parent requests to the active span', () => {
+    const startup = startActiveSpan('app.startup');
+    const { span, headers } = startRequestSpan('GET', 'http://api.test/histories');
+    expect(span.traceId).toBe(startup.traceId);
+    expect(headers.traceparent).toBe(toTraceparent(span));
+    expect(headers.tracestate).toBe('vendor=abc');
+
+    startup.end();
+    expect(getActiveSpan()).toBeNull();
+    expect(startRequestSpan('GET', 'http://api.test/histories').span.traceId).not.toBe(startup.traceId);
+  });
+
+  it('should restore the enclosing active span when a nested one ends', () => {
+    const outer = startActiveSpan('app.startup');
+    const inner = startActiveSpan('ui.refresh');
+    expect(inner.traceId).toBe(outer.traceId);
+
+    outer.end();
+    expect(getActiveSpan()?.spanId).toBe(inner.spanId);
+    inner.end();
+    expect(getActiveSpan()).toBeNull();
+  });
+
+  it('should export finished spans as OTLP JSON', async () => {
+    const fetchMock = jest.fn((_url: string, _init: RequestInit) => Promise.resolve({ ok: true, status: 200 } as Response));
+    global.fetch = fetchMock as unknown as typeof fetch;
+
+    const { span } = startRequestSpan('POST', 'http://api.test/histories?x=1');
+    endRequestSpan(span, 201, { start: 1000, headers: 1040, end: 1050 });
+    await exportSpans();
+
+    expect(fetchMock).toHaveBeenCalledTimes(1);
+    const [url, init] = fetchMock.mock.calls[0];
+    expect(url).toBe('http://collector.test/v1/traces');
+    const spans = JSON.parse(init.body as string).resourceSpans[0].scopeSpans[0].spans;
+    const exported = spans.find((s: { spanId: string }) => s.spanId === span.spanId);
+    expect(exported.name).toBe('POST /histories');
+    expect(exported.parentSpanId).toBeUndefined();
+    expect(JSON.parse(init.body as string).resourceSpans[0].resource.attributes).toContainEqual({
+      key: 'session.id',
+      value: { stringValue: getSessionId() },
+    });
+    expect(exported.attributes).toContainEqual({ key: 'http.ttfb_ms', value: { intValue: 40 } });
+
+    fetchMock.mockClear();
+    await exportSpans();
+    expect(fetchMock).not.toHaveBeenCalled();
+  });
+
+  it('should send a batch once when exports overlap', async () => {
+    let respond!: (response: Response) => void;
+    const fetchMock = jest.fn(() => new Promise<Response>((resolve) => { respond = resolve; }));
+    global.fetch = fetchMock as unknown as typeof fetch;
+
+    const { span } = startRequestSpan('GET', 'http://api.test/histories');
+    endRequestSpan(span, 200, { start: 0, end: 1 });
+    const first = exportSpans();
+    const second = exportSpans();
+    respond({ ok: true, status: 200 } as Response);
+    await Promise.all([first, second]);
+
+    expect(fetchMock).toHaveBeenCalledTimes(1);
+  });
+
+  it('should keep spans that failed to export for the next attempt', async () => {
+    const fetchMock = jest.fn(() => Promise.resolve({ ok: false, status: 503 } as Response));
+    global.fetch = fetchMock as unknown as typeof fetch;
+
+    const { span } = startRequestSpan('GET', 'http://api.test/histories');
+    endRequestSpan(span, 200, { start: 0, end: 1 });
+    await expect(exportSpans()).rejects.toThrow('HTTP 503');
+
+    fetchMock.mockImplementation(() => Promise.resolve({ ok: true, status: 200 } as Response));
+    await exportSpans();
+    const body = JSON.parse((fetchMock.mock.calls[1] as unknown as [string, RequestInit])[1].body as string);
+    const spanIds = body.resourceSpans[0].scopeSpans[0].spans.map((s: { spanId: string }) => s.spanId);
+    expect(spanIds).toContain(span.spanId);
+  });
+});
@@ -0,0 +1,189 @@
+/**
+ * Batched analytics pipeline for desktop (macOS / Windows)
+ *
+ * Firebase Analytics is native-only, so desktop builds record events here
+ * instead. {@link DesktopAnalyticsService.logEvent} is fire-and-forget: it
+ * writes into a fixed-size ring buffer and returns. A coalesced flush timer
+ * moves buffered events into a persisted queue in AsyncStorage (so events
+ * survive restarts) and uploads the queue in batches to
+ * `EXPO_PUBLIC_ANALYTICS_URL`, retrying with exponential backoff; while a
+ * backoff is pending no flush uploads, however it was triggered. Batches the
+ * collector rejects with a 4xx (other than 408 / 429) are dropped rather
+ * than retried forever. Uploads are held while offline and resume on
+ * reconnect.
+ *
+ * Batches are sent uncompressed: Hermes has no `CompressionStream` and the
+ * app carries no compression library, and a batch of 200 small events is
+ * only tens of kilobytes.
+ *
+ * When no collector URL is configured, events are only persisted (up to
+ * {@link MAX_PERSISTED_EVENTS}).
+ *
+ * @module services/analytics
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { Platform } from 'react-native';
+import { env } from '@/config/env';
+import { STORAGE_KEYS } from '@/config/constants';
+import { scheduleTimeout, type TimerHandle } from '@/services/scheduler';
+import { isOnline, onReconnect } from '@/services/reachability';
+
+/** A single recorded analytics event. */
+export interface AnalyticsEvent {
+  name: string;
+  params?: Record<string, unknown>;
+  /** Epoch milliseconds when the event was logged. */
+  timestamp: number;
+}
+
+/** In-memory ring capacity; the oldest events are dropped when full. */
+const RING_CAPACITY = 512;
+/** Upper bound on events kept on disk while the collector is unreachable. */
+const MAX_PERSISTED_EVENTS = 5000;
+/** Events per upload request. */
+const UPLOAD_BATCH_SIZE = 200;
+/** Delay between the first buffered event and the flush. */
+const FLUSH_DELAY_MS = 30 * 1000;
+const FLUSH_TOLERANCE_MS = 30 * 1000;
+const MAX_BACKOFF_MS = 30 * 60 * 1000;
+
+/** Whether the collector refused a batch for good (retrying won't help). */
+function isRejected(status: number): boolean {
+  return status >= 400 && status < 500 && status !== 408 && status !== 429;
+}
+
+/**
+ * Desktop analytics service with a ring buffer, persisted queue and
+ * background uploads.
+ */
+export class DesktopAnalyticsService {
+  private readonly ring: (AnalyticsEvent | undefined)[] = new Array(RING_CAPACITY);
+  private head = 0;
+  private size = 0;
+  private flushTimer: TimerHandle | null = null;
+  private flushing = false;
+  private failedUploads = 0;
+  /** Epoch milliseconds before which no upload is attempted (backoff). */
+  private retryAfter = 0;
+
+  constructor() {
+    onReconnect(() => {
+      this.failedUploads = 0;
+      this.retryAfter = 0;
+      this.flush();
+    });
+  }
+
+  /**
+   * Record an event. Never blocks and never throws.
+   *
+   * @param name - Event name, e.g. `history_created`.
+   * @param params - Optional JSON-serialisable event parameters.
+   */
+  logEvent(name: string, params?: Record<string, unknown>): void {
+    const tail = (this.head + this.size) % RING_CAPACITY;
+    this.ring[tail] = { name, params, timestamp: Date.now() };
+    if (this.size < RING_CAPACITY) {
+      this.size++;
+    } else {
+      this.head = (this.head + 1) % RING_CAPACITY;
+    }
+    this.scheduleFlush(FLUSH_DELAY_MS);
+  }
+
+  /** Persist buffered events and upload the queue now, unless backing off. */
+  async flush(): Promise<void> {
+    if (this.flushing) {
+      this.scheduleFlush(FLUSH_DELAY_MS);
+      return;
+    }
+    this.flushTimer?.cancel();
+    this.flushTimer = null;
+    this.flushing = true;
+    try {
+      const queue = await this.persist(this.drain());
+      if (queue.length > 0 && env.ANALYTICS_URL && isOnline()) {
+        // Still backing off: only persist, and come back when it ends
+        if (Date.now() < this.retryAfter) this.scheduleFlush(0);
+        else await this.upload(queue);
+      }
+    } catch (error) {
+      console.error('[Analytics] Flush failed:', error);
+    } finally {
+      this.flushing = false;
+    }
+  }
+
+  /** Schedule a flush in `delayMs`, or when the backoff ends if later. */
+  private scheduleFlush(delayMs: number): void {
+    if (this.flushTimer) return;
+    const delay = Math.max(delayMs, this.retryAfter - Date.now());
+    this.flushTimer = scheduleTimeout(() => {
+      this.flushTimer = null;
+      this.flush();
+    }, delay, { toleranceMs: FLUSH_TOLERANCE_MS });
+  }
+
+  /** Remove and return all events currently in the ring. */
+  private drain(): AnalyticsEvent[] {
+    const events: AnalyticsEvent[] = [];
+    for (let i = 0; i < this.size; i++) {
+      const index = (this.head + i) % RING_CAPACITY;
+      events.push(this.ring[index] as AnalyticsEvent);
+      this.ring[index] = undefined;
+    }
+    this.head = 0;
+    this.size = 0;
+    return events;
+  }
+
+  /** Append `events` to the persisted queue and return the full queue. */
+  private async persist(events: AnalyticsEvent[]): Promise<AnalyticsEvent[]> {
+    const stored = await AsyncStorage.getItem(STORAGE_KEYS.ANALYTICS_QUEUE);
+    let queue: AnalyticsEvent[] = stored ? JSON.parse(stored) : [];
+    if (events.length === 0) return queue;
+    queue = queue.concat(events).slice(-MAX_PERSISTED_EVENTS);
+    await AsyncStorage.setItem(STORAGE_KEYS.ANALYTICS_QUEUE, JSON.stringify(queue));
+    return queue;
+  }
+
+  /**
+   * Upload the queue in batches, keeping whatever could not be sent.
+   * Batches rejected as malformed (4xx other than 408 / 429) count as sent.
+   */
+  private async upload(queue: AnalyticsEvent[]): Promise<void> {
+    let sent = 0;
+    try {
+      while (sent < queue.length) {
+        const batch = queue.slice(sent, sent + UPLOAD_BATCH_SIZE);
+        const response = await fetch(env.ANALYTICS_URL, {
+          method: 'POST',
+          headers: { 'Content-Type': 'application/json' },
+          body: JSON.stringify({ platform: Platform.OS, events: batch }),
+        });
+        if (isRejected(response.status)) {
+          console.warn(`[Analytics] Collector rejected ${batch.length} events (HTTP ${response.status}), dropping them`);
+        } else if (!response.ok) {
+          throw new Error(`HTTP ${response.status}`);
+        }
+        sent += batch.length;
+      }
+      this.failedUploads = 0;
+      this.retryAfter = 0;
+    } catch (error) {
+      this.failedUploads++;
+      const backoff = Math.min(FLUSH_DELAY_MS * 2 ** this.failedUploads, MAX_BACKOFF_MS);
+      console.warn(`[Analytics] Upload failed, retrying in ${backoff / 1000}s:`, error);
+      // Replace any sooner flush (e.g. from a logEvent during the upload)
+      this.retryAfter = Date.now() + backoff;
+      this.flushTimer?.cancel();
+      this.flushTimer = null;
+      this.scheduleFlush(backoff);
+    }
+
+    if (sent > 0) {
+      await AsyncStorage.setItem(STORAGE_KEYS.ANALYTICS_QUEUE, JSON.stringify(queue.slice(sent)));
+    }
+  }
+}
@@ -0,0 +1,26 @@
+/**
+ * Current auth token holder
+ *
+ * Keeps the latest Firebase ID token outside of React state. The auth
+ * providers write every new token here (sign-in, periodic refresh, explicit
+ * refresh, sign-out), and the API network client reads it on every request
+ * to attach the `Authorization` header itself.
+ *
+ * Because a token rotation only updates this holder, it does not change any
+ * context value and causes no React re-renders. The `token` exposed by
+ * `AuthContext` / `ApiContext` only changes when the user signs in or out.
+ *
+ * @module services/authToken
+ */
+
+let currentToken: string | null = null;
+
+/** Return the most recent ID token, or `null` when signed out. */
+export function getAuthToken(): string | null {
+  return currentToken;
+}
+
+/** Record a new ID token (or `null` on sign-out). */
+export function setAuthToken(token: string | null): void {
+  currentToken = token;
+}
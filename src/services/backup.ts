@@ -0,0 +1,201 @@
+/**
+ * Incremental local backups of user preferences
+ *
+ * Copies the app's own AsyncStorage entries (settings, language) into a
+ * single backup document kept outside the storage it protects: a native
+ * file on Windows (see `native/Backup`), and a separate AsyncStorage key
+ * ({@link STORAGE_KEYS.BACKUP}) on platforms without one, which guards
+ * against corrupt or cleared entries but not against losing the whole
+ * database. A backup compares every value with the previous document and
+ * writes only when something changed, so it costs one batched read and can
+ * run on a background timer without stalling other storage traffic.
+ *
+ * At startup, {@link restoreMissingPreferences} puts back entries that are
+ * missing or unreadable before the next backup could forget them; the user
+ * can restore everything from Settings with {@link restoreBackup}.
+ *
+ * Histories are not included: they live on the server and are re-fetched.
+ * The auth session and analytics queue are excluded on purpose.
+ *
+ * @module services/backup
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { STORAGE_KEYS } from '@/config/constants';
+import { loadStoredLanguagePreference } from '@/i18n';
+import { hasNativeBackupFile, readBackupFile, writeBackupFile } from '@/native/Backup';
+import { scheduleInterval, type TimerHandle } from '@/services/scheduler';
+import { useSettingsStore } from '@/stores/settingsStore';
+
+function isJsonObject(value: string): boolean {
+  try {
+    const parsed: unknown = JSON.parse(value);
+    return typeof parsed === 'object' && parsed !== null;
+  } catch {
+    return false;
+  }
+}
+
+/** Entries included in backups, with a check that a stored value is usable. */
+const BACKED_UP_ENTRIES: Record<string, (value: string) => boolean> = {
+  'starter-settings': isJsonObject,
+  [STORAGE_KEYS.LANGUAGE]: (value) => value.length > 0,
+};
+const BACKED_UP_KEYS = Object.keys(BACKED_UP_ENTRIES);
+
+const AUTO_BACKUP_INTERVAL_MS = 60 * 60 * 1000;
+const AUTO_BACKUP_TOLERANCE_MS = 15 * 60 * 1000;
+
+interface BackupDocument {
+  /** Epoch milliseconds of the last backup that changed anything. */
+  createdAt: number;
+  /** Backed-up values, by source key. */
+  entries: Record<string, string>;
+}
+
+/** Outcome of {@link createBackup}. */
+export interface BackupResult {
+  /** Entries copied because they were new or changed. */
+  written: number;
+  /** Entries skipped because the backup was already current. */
+  unchanged: number;
+  /** Entries removed from the backup because the source no longer exists. */
+  removed: number;
+}
+
+async function readDocument(): Promise<BackupDocument | null> {
+  const stored = hasNativeBackupFile()
+    ? await readBackupFile()
+    : await AsyncStorage.getItem(STORAGE_KEYS.BACKUP);
+  if (!stored) return null;
+  try {
+    const document = JSON.parse(stored) as BackupDocument;
+    return document && typeof document.entries === 'object' ? document : null;
+  } catch {
+    return null;
+  }
+}
+
+async function writeDocument(document: BackupDocument): Promise<void> {
+  const contents = JSON.stringify(document);
+  if (hasNativeBackupFile()) await writeBackupFile(contents);
+  else await AsyncStorage.setItem(STORAGE_KEYS.BACKUP, contents);
+}
+
+let running: Promise<BackupResult> | null = null;
+
+async function runBackup(): Promise<BackupResult> {
+  const [document, stored] = await Promise.all([
+    readDocument(),
+    AsyncStorage.multiGet(BACKED_UP_KEYS),
+  ]);
+  const previous = document?.entries ?? {};
+  const entries: Record<string, string> = {};
+  let written = 0;
+  let unchanged = 0;
+  let removed = 0;
+
+  for (const [key, value] of stored) {
+    if (value === null) {
+      if (previous[key] !== undefined) removed++;
+      continue;
+    }
+    entries[key] = value;
+    // Compare the values themselves; they are small
+    if (previous[key] === value) unchanged++;
+    else written++;
+  }
+
+  if (document && written === 0 && removed === 0) {
+    return { written, unchanged, removed };
+  }
+  await writeDocument({ createdAt: Date.now(), entries });
+  return { written, unchanged, removed };
+}
+
+/**
+ * Bring the backup up to date; nothing is written when no entry changed.
+ * Concurrent calls share one run.
+ */
+export function createBackup(): Promise<BackupResult> {
+  if (!running) {
+    running = runBackup().finally(() => {
+      running = null;
+    });
+  }
+  return running;
+}
+
+/** Epoch milliseconds of the last backup that changed anything, or `null`. */
+export async function getLastBackupTime(): Promise<number | null> {
+  return (await readDocument())?.createdAt ?? null;
+}
+
+/**
+ * Copy backed-up entries back into AsyncStorage, then reload the settings
+ * store and re-apply the stored language.
+ *
+ * @param onlyUnusable - Restore only entries that are missing or fail their
+ *   validity check, keeping healthy ones as they are.
+ * @returns The number of entries restored (0 when there is no backup).
+ */
+async function restoreEntries(onlyUnusable: boolean): Promise<number> {
+  const document = await readDocument();
+  if (!document) return 0;
+  const keys = BACKED_UP_KEYS.filter((key) => document.entries[key] !== undefined);
+  const current = onlyUnusable ? await AsyncStorage.multiGet(keys) : [];
+  const restores: [string, string][] = [];
+  keys.forEach((key, i) => {
+    const value = current[i]?.[1] ?? null;
+    if (onlyUnusable && value !== null && BACKED_UP_ENTRIES[key](value)) return;
+    restores.push([key, document.entries[key]]);
+  });
+  if (restores.length === 0) return 0;
+
+  await AsyncStorage.multiSet(restores);
+  if (restores.some(([key]) => key === 'starter-settings')) {
+    await useSettingsStore.persist.rehydrate();
+  }
+  if (restores.some(([key]) => key === STORAGE_KEYS.LANGUAGE)) {
+    await loadStoredLanguagePreference();
+  }
+  return restores.length;
+}
+
+/**
+ * Restore every backed-up entry, reload the settings store and re-apply the
+ * language.
+ *
+ * @returns The number of entries restored (0 when there is no backup).
+ */
+export function restoreBackup(): Promise<number> {
+  return restoreEntries(false);
+}
+
+/**
+ * Restore only the entries that are missing or unreadable. Run at startup,
+ * before {@link startAutoBackup}, so a damaged entry is recovered rather
+ * than dropped from the backup, and before the UI can change settings, so
+ * the restore can't overwrite such a change.
+ *
+ * @returns The number of entries restored.
+ */
+export function restoreMissingPreferences(): Promise<number> {
+  return restoreEntries(true);
+}
+
+let autoBackup: TimerHandle | null = null;
+
+/** Back up hourly (coalesced with other timers). Safe to call more than once. */
+export function startAutoBackup(): void {
+  if (autoBackup) return;
+  autoBackup = scheduleInterval(() => {
+    createBackup().catch((error) => console.error('[Backup] Backup failed:', error));
+  }, AUTO_BACKUP_INTERVAL_MS, { toleranceMs: AUTO_BACKUP_TOLERANCE_MS });
+}
+
+/** Stop automatic backups. */
+export function stopAutoBackup(): void {
+  autoBackup?.cancel();
+  autoBackup = null;
+}
@@ -0,0 +1,98 @@
+/**
+ * Periodic diagnostics report
+ *
+ * The consumer of the metrics registry: every 15 minutes (coalesced with
+ * other timers), and whenever the app is hidden, the current
+ * {@link getMetricsSnapshot} is written as one JSON line to the native
+ * diagnostic log (`%LOCALAPPDATA%\StarterApp\diagnostics.log` on Windows)
+ * together with the long frames recorded by the frame monitor, and both are
+ * reset, so each report covers one interval. That includes heap / GC
+ * telemetry, frame timing, `app.hidden.*`, HTTP phase timings, thread
+ * stalls and, on Windows, the native CPU time per work class
+ * (`native.cpu.*`, cumulative since launch).
+ *
+ * Where there is no diagnostic log the report is printed to the console in
+ * dev mode, and otherwise dropped.
+ *
+ * @module services/diagnosticsReport
+ */
+
+import { env } from '@/config/env';
+import { appendDiagnosticLog, getThreadCpuTimes } from '@/native/Diagnostics';
+import { clearLongFrames, getLongFrames, type LongFrame } from '@/services/frameTiming';
+import { getMetricsSnapshot, resetMetrics, setGauge, type MetricsSnapshot } from '@/services/metrics';
+import { scheduleInterval, type TimerHandle } from '@/services/scheduler';
+
+const REPORT_INTERVAL_MS = 15 * 60 * 1000;
+const REPORT_TOLERANCE_MS = 5 * 60 * 1000;
+
+/** One line of the diagnostic log. */
+export interface DiagnosticsReport {
+  type: 'metrics';
+  /** Epoch milliseconds when the report was taken. */
+  takenAt: number;
+  metrics: MetricsSnapshot;
+  /** Long frames since the last report, oldest first. */
+  longFrames: LongFrame[];
+}
+
+let timer: TimerHandle | null = null;
+
+function isEmpty(snapshot: MetricsSnapshot): boolean {
+  return Object.keys(snapshot.gauges).length === 0 && Object.keys(snapshot.histograms).length === 0;
+}
+
+/**
+ * Write the current metrics and long frames to the diagnostic log and reset
+ * them. Does nothing when nothing was recorded since the last report.
+ *
+ * @returns The report written, or `null` if there was nothing to report.
+ */
+export function writeDiagnosticsReport(): DiagnosticsReport | null {
+  const metrics = getMetricsSnapshot();
+  const longFrames = getLongFrames();
+  if (isEmpty(metrics) && longFrames.length === 0) return null;
+
+  const report: DiagnosticsReport = { type: 'metrics', takenAt: Date.now(), metrics, longFrames };
+  const line = JSON.stringify(report);
+  if (!appendDiagnosticLog(line)) {
+    if (!env.DEV_MODE) return null;
+    console.log('[Diagnostics]', line);
+  }
+  resetMetrics();
+  clearLongFrames();
+  return report;
+}
+
+/** Record the native CPU time per work class as `native.cpu.*` gauges. */
+async function recordThreadCpuTimes(): Promise<void> {
+  const times = await getThreadCpuTimes().catch(() => null);
+  if (!times) return;
+  setGauge('native.cpu.interactive', times.interactive);
+  setGauge('native.cpu.utility', times.utility);
+  setGauge('native.cpu.background', times.background);
+}
+
+/**
+ * Sample the native CPU times, then {@link writeDiagnosticsReport}.
+ *
+ * @returns The report written, or `null` if there was nothing to report.
+ */
+export async function reportDiagnostics(): Promise<DiagnosticsReport | null> {
+  await recordThreadCpuTimes();
+  return writeDiagnosticsReport();
+}
+
+/** Write a report every 15 minutes. Safe to call more than once. */
+export function startDiagnosticsReports(): void {
+  if (timer) return;
+  timer = scheduleInterval(() => {
+    reportDiagnostics().catch(() => {});
+  }, REPORT_INTERVAL_MS, { toleranceMs: REPORT_TOLERANCE_MS });
+}
+
+/** Stop the periodic reports. */
+export function stopDiagnosticsReports(): void {
+  timer?.cancel();
+  timer = null;
+}
@@ -0,0 +1,386 @@
+/**
+ * Firebase Authentication over REST for desktop (macOS / Windows)
+ *
+ * Desktop builds only need a handful of Firebase Auth operations: email /
+ * password sign-in and sign-up, Google credential sign-in, password reset
+ * and ID token refresh. This client calls the Identity Toolkit and Secure
+ * Token REST endpoints directly with `fetch`, so desktop startup no longer
+ * parses and initialises the Firebase JS SDK.
+ *
+ * The session (profile, ID token, refresh token, expiry) is persisted to
+ * AsyncStorage under {@link STORAGE_KEYS.AUTH_SESSION} and restored with
+ * {@link FirebaseAuthRestClient.restore}, which also carries over a user
+ * persisted by the Firebase JS SDK that earlier desktop builds used.
+ *
+ * @module services/firebaseAuthRest
+ */
+
+import AsyncStorage from '@react-native-async-storage/async-storage';
+import { STORAGE_KEYS } from '@/config/constants';
+
+const IDENTITY_TOOLKIT_URL = 'https://identitytoolkit.googleapis.com/v1';
+const SECURE_TOKEN_URL = 'https://securetoken.googleapis.com/v1';
+
+/** Refresh the ID token when it expires within this window. */
+const EXPIRY_MARGIN_MS = 5 * 60 * 1000;
+
+/** A signed-in Firebase user and its tokens. */
+export interface AuthSession {
+  uid: string;
+  email: string | null;
+  displayName: string | null;
+  photoURL: string | null;
+  isAnonymous: boolean;
+  idToken: string;
+  refreshToken: string;
+  /** Epoch milliseconds at which `idToken` expires. */
+  expiresAt: number;
+}
+
+/**
+ * Error raised for failed auth requests. `code` follows the Firebase JS SDK
+ * naming (`auth/wrong-password`, ...) so callers can branch the same way.
+ */
+export class FirebaseAuthError extends Error {
+  constructor(readonly code: string, message: string) {
+    super(message);
+    this.name = 'FirebaseAuthError';
+  }
+}
+
+/** REST error message (prefix) to SDK-style error code and message. */
+const ERROR_CODES: Record<string, [string, string]> = {
+  EMAIL_EXISTS: ['auth/email-already-in-use', 'The email address is already in use by another account.'],
+  EMAIL_NOT_FOUND: ['auth/user-not-found', 'There is no user record corresponding to this email.'],
+  INVALID_PASSWORD: ['auth/wrong-password', 'The password is invalid.'],
+  INVALID_LOGIN_CREDENTIALS: ['auth/invalid-credential', 'The email or password is incorrect.'],
+  INVALID_EMAIL: ['auth/invalid-email', 'The email address is badly formatted.'],
+  WEAK_PASSWORD: ['auth/weak-password', 'Password should be at least 6 characters.'],
+  USER_DISABLED: ['auth/user-disabled', 'This account has been disabled.'],
+  TOO_MANY_ATTEMPTS_TRY_LATER: ['auth/too-many-requests', 'Too many attempts. Try again later.'],
+  TOKEN_EXPIRED: ['auth/user-token-expired', 'Your session has expired. Please sign in again.'],
+  INVALID_REFRESH_TOKEN: ['auth/invalid-refresh-token', 'Your session has expired. Please sign in again.'],
+  USER_NOT_FOUND: ['auth/user-not-found', 'This account no longer exists.'],
+  INVALID_IDP_RESPONSE: ['auth/invalid-credential', 'The Google credential is invalid.'],
+};
+
+function toAuthError(status: number, body: unknown): FirebaseAuthError {
+  const error = (body as { error?: { message?: unknown } | string } | null)?.error;
+  const raw = typeof error === 'string' ? error : typeof error?.message === 'string' ? error.message : '';
+  // Messages may carry detail after a colon, e.g. "WEAK_PASSWORD : Password should be..."
+  const key = raw.split(/[\s:]/)[0].toUpperCase();
+  const known = ERROR_CODES[key];
+  if (known) return new FirebaseAuthError(known[0], known[1]);
+  return new FirebaseAuthError('auth/internal-error', raw || `Auth request failed (${status})`);
+}
+
+interface IdentityToolkitResponse {
+  localId: string;
+  email?: string;
+  displayName?: string;
+  photoUrl?: string;
+  idToken: string;
+  refreshToken: string;
+  expiresIn: string;
+}
+
+interface SecureTokenResponse {
+  id_token: string;
+  refresh_token: string;
+  expires_in: string;
+  user_id: string;
+}
+
+/** Options for {@link FirebaseAuthRestClient}. */
+export interface FirebaseAuthRestOptions {
+  apiKey: string;
+  /** Override the Identity Toolkit base URL (e.g. the Auth emulator). */
+  identityToolkitUrl?: string;
+  /** Override the Secure Token base URL. */
+  secureTokenUrl?: string;
+}
+
+type SessionListener = (session: AuthSession | null) => void;
+
+/** The parts of a user record persisted by the Firebase JS SDK that are kept. */
+interface LegacyUserRecord {
+  uid?: unknown;
+  email?: string | null;
+  displayName?: string | null;
+  photoURL?: string | null;
+  isAnonymous?: boolean;
+  stsTokenManager?: {
+    refreshToken?: unknown;
+    accessToken?: unknown;
+    expirationTime?: unknown;
+  };
+}
+
+/** AsyncStorage key of the user persisted by the Firebase JS SDK (`getReactNativePersistence`). */
+function legacySessionKey(apiKey: string): string {
+  return `firebase:authUser:${apiKey}:[DEFAULT]`;
+}
+
+/**
+ * Convert a Firebase JS SDK user record into a session, or `null` if it
+ * lacks a uid or refresh token. Without a usable ID token the session is
+ * marked expired, so the first {@link FirebaseAuthRestClient.getIdToken}
+ * refreshes it.
+ */
+function fromLegacyRecord(stored: string): AuthSession | null {
+  let record: LegacyUserRecord;
+  try {
+    record = JSON.parse(stored) as LegacyUserRecord;
+  } catch {
+    return null;
+  }
+  const tokens = record?.stsTokenManager;
+  if (typeof record?.uid !== 'string' || typeof tokens?.refreshToken !== 'string') return null;
+  const hasIdToken = typeof tokens.accessToken === 'string' && typeof tokens.expirationTime === 'number';
+  return {
+    uid: record.uid,
+    email: record.email ?? null,
+    displayName: record.displayName ?? null,
+    photoURL: record.photoURL ?? null,
+    isAnonymous: record.isAnonymous ?? false,
+    idToken: hasIdToken ? (tokens.accessToken as string) : '',
+    refreshToken: tokens.refreshToken,
+    expiresAt: hasIdToken ? (tokens.expirationTime as number) : 0,
+  };
+}
+
+/**
+ * Minimal Firebase Auth client backed by the REST API.
+ *
+ * @example
+ * ```ts
+ * const client = new FirebaseAuthRestClient({ apiKey });
+ * client.onSessionChanged((session) => console.log(session?.uid));
+ * await client.restore();
+ * await client.signInWithPassword(email, password);
+ * const token = await client.getIdToken();
+ * ```
+ */
+export class FirebaseAuthRestClient {
+  private session: AuthSession | null = null;
+  /** Bumped on every sign-in / sign-out, so in-flight work can tell it is stale. */
+  private generation = 0;
+  private refreshing: Promise<string | null> | null = null;
+  private readonly listeners = new Set<SessionListener>();
+  private readonly identityToolkitUrl: string;
+  private readonly secureTokenUrl: string;
+
+  constructor(private readonly options: FirebaseAuthRestOptions) {
+    this.identityToolkitUrl = options.identityToolkitUrl ?? IDENTITY_TOOLKIT_URL;
+    this.secureTokenUrl = options.secureTokenUrl ?? SECURE_TOKEN_URL;
+  }
+
+  /** The current session, or `null` when signed out. */
+  get currentSession(): AuthSession | null {
+    return this.session;
+  }
+
+  /**
+   * Subscribe to sign-in / sign-out. Token refreshes do not notify.
+   *
+   * @returns An unsubscribe function.
+   */
+  onSessionChanged(listener: SessionListener): () => void {
+    this.listeners.add(listener);
+    return () => {
+      this.listeners.delete(listener);
+    };
+  }
+
+  /**
+   * Load the persisted session, if any, and notify listeners. A sign-in or
+   * sign-out that completes while the session is being read wins: the stored
+   * session is then discarded and the current one returned.
+   *
+   * When there is no session of its own, a user persisted by the Firebase JS
+   * SDK is converted once, saved under {@link STORAGE_KEYS.AUTH_SESSION} and
+   * its SDK record removed, so upgrading does not sign the user out.
+   */
+  async restore(): Promise<AuthSession | null> {
+    const generation = this.generation;
+    let restored: AuthSession | null = null;
+    let legacy: string | null = null;
+    try {
+      const stored = await AsyncStorage.getItem(STORAGE_KEYS.AUTH_SESSION);
+      if (stored) {
+        restored = JSON.parse(stored) as AuthSession;
+      } else {
+        legacy = await AsyncStorage.getItem(legacySessionKey(this.options.apiKey));
+        restored = legacy ? fromLegacyRecord(legacy) : null;
+      }
+    } catch (error) {
+      console.error('[Auth] Failed to restore session:', error);
+    }
+    if (generation !== this.generation) return this.session;
+    this.session = restored;
+    if (legacy !== null) {
+      await this.persist();
+      await AsyncStorage.removeItem(legacySessionKey(this.options.apiKey)).catch(() => {});
+      if (generation !== this.generation) return this.session;
+    }
+    this.notify();
+    return restored;
+  }
+
+  /** Sign in with email and password. */
+  async signInWithPassword(email: string, password: string): Promise<AuthSession> {
+    const response = await this.identityToolkit<IdentityToolkitResponse>('accounts:signInWithPassword', {
+      email,
+      password,
+      returnSecureToken: true,
+    });
+    return this.setSession(response);
+  }
+
+  /** Create an account with email and password and sign in to it. */
+  async signUp(email: string, password: string): Promise<AuthSession> {
+    const response = await this.identityToolkit<IdentityToolkitResponse>('accounts:signUp', {
+      email,
+      password,
+      returnSecureToken: true,
+    });
+    return this.setSession(response);
+  }
+
+  /**
+   * Sign in with a Google ID token obtained from the OAuth flow.
+   *
+   * @param googleIdToken - The `id_token` from Google's token endpoint.
+   */
+  async signInWithGoogleIdToken(googleIdToken: string): Promise<AuthSession> {
+    const response = await this.identityToolkit<IdentityToolkitResponse>('accounts:signInWithIdp', {
+      postBody: `id_token=${encodeURIComponent(googleIdToken)}&providerId=google.com`,
+      requestUri: 'http://localhost',
+      returnSecureToken: true,
+      returnIdpCredential: true,
+    });
+    return this.setSession(response);
+  }
+
+  /** Send a password-reset email. */
+  async sendPasswordResetEmail(email: string): Promise<void> {
+    await this.identityToolkit('accounts:sendOobCode', { requestType: 'PASSWORD_RESET', email });
+  }
+
+  /** Clear the session locally and from storage. */
+  async signOut(): Promise<void> {
+    this.session = null;
+    this.generation++;
+    this.refreshing = null;
+    await AsyncStorage.removeItem(STORAGE_KEYS.AUTH_SESSION);
+    this.notify();
+  }
+
+  /**
+   * Return a valid ID token, refreshing it when it is about to expire (or
+   * always when `forceRefresh` is set). Concurrent callers share one refresh.
+   *
+   * @returns The ID token, or `null` when signed out, including when the
+   *   user signs out or another user signs in while the refresh is in flight
+   *   (the refreshed token belongs to the previous session and is dropped).
+   * @throws {FirebaseAuthError} If the refresh is rejected. An invalid or
+   *   revoked refresh token also signs the user out.
+   */
+  async getIdToken(forceRefresh = false): Promise<string | null> {
+    const session = this.session;
+    if (!session) return null;
+    if (!forceRefresh && session.expiresAt - Date.now() > EXPIRY_MARGIN_MS) {
+      return session.idToken;
+    }
+    if (!this.refreshing) {
+      this.refreshing = this.refresh(session).finally(() => {
+        this.refreshing = null;
+      });
+    }
+    return this.refreshing;
+  }
+
+  private async refresh(session: AuthSession): Promise<string | null> {
+    let response: SecureTokenResponse;
+    try {
+      response = await this.post<SecureTokenResponse>(
+        `${this.secureTokenUrl}/token?key=${encodeURIComponent(this.options.apiKey)}`,
+        `grant_type=refresh_token&refresh_token=${encodeURIComponent(session.refreshToken)}`,
+        'application/x-www-form-urlencoded'
+      );
+    } catch (error) {
+      if (
+        error instanceof FirebaseAuthError &&
+        ['auth/invalid-refresh-token', 'auth/user-token-expired', 'auth/user-disabled', 'auth/user-not-found'].includes(error.code) &&
+        this.session === session
+      ) {
+        await this.signOut();
+      }
+      throw error;
+    }
+
+    // The user may have signed out (or switched accounts) meanwhile; the
+    // new token belongs to the old session and must not be handed out.
+    if (this.session !== session) return null;
+    this.session = {
+      ...session,
+      idToken: response.id_token,
+      refreshToken: response.refresh_token,
+      expiresAt: Date.now() + Number(response.expires_in) * 1000,
+    };
+    await this.persist();
+    return response.id_token;
+  }
+
+  private async setSession(response: IdentityToolkitResponse): Promise<AuthSession> {
+    this.session = {
+      uid: response.localId,
+      email: response.email ?? null,
+      displayName: response.displayName ?? null,
+      photoURL: response.photoUrl ?? null,
+      isAnonymous: false,
+      idToken: response.idToken,
+      refreshToken: response.refreshToken,
+      expiresAt: Date.now() + Number(response.expiresIn) * 1000,
+    };
+    this.generation++;
+    this.refreshing = null;
+    await this.persist();
+    this.notify();
+    return this.session;
+  }
+
+  private async persist(): Promise<void> {
+    if (!this.session) return;
+    try {
+      await AsyncStorage.setItem(STORAGE_KEYS.AUTH_SESSION, JSON.stringify(this.session));
+    } catch (error) {
+      console.error('[Auth] Failed to persist session:', error);
+    }
+  }
+
+  private notify(): void {
+    for (const listener of this.listeners) {
+      listener(this.session);
+    }
+  }
+
+  private identityToolkit<T>(method: string, body: Record<string, unknown>): Promise<T> {
+    return this.post<T>(
+      `${this.identityToolkitUrl}/${method}?key=${encodeURIComponent(this.options.apiKey)}`,
+      JSON.stringify(body),
+      'application/json'
+    );
+  }
+
+  private async post<T>(url: string, body: string, contentType: string): Promise<T> {
+    const response = await fetch(url, {
+      method: 'POST',
+      headers: { 'Content-Type': contentType },
+      body,
+    });
+    const json: unknown = await response.json().catch(() => null);
+    if (!response.ok) throw toAuthError(response.status, json);
+    return json as T;
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * Frame timing and jank instrumentation
+ *
+ * Measures the interval between consecutive `requestAnimationFrame`
+ * callbacks, which is how often the JS thread gets to run per UI frame.
+ * Every interval is recorded into the `ui.frame` histogram; intervals longer
+ * than {@link LONG_FRAME_MS} additionally go into `ui.frame.long` and a
+ * small ring of recent long frames, each with the number of garbage
+ * collections that ran during it, so jank can be attributed to GC.
+ *
+ * Keeping a rAF loop alive wakes the JS thread every frame (and the GC count
+ * is read from Hermes on each one), so the monitor is opt-in (started in dev
+ * builds only).
+ *
+ * @module services/frameTiming
+ */
+
+import { readGcCount } from '@/services/heapTelemetry';
+import { recordHistogram } from '@/services/metrics';
+
+/** Frames longer than this (ms) count as long frames (~3 frames at 60 Hz). */
+const LONG_FRAME_MS = 50;
+/** Number of recent long frames kept for inspection. */
+const LONG_FRAME_HISTORY = 32;
+
+/** A frame that took longer than {@link LONG_FRAME_MS}. */
+export interface LongFrame {
+  /** Epoch milliseconds when the frame ended. */
+  endedAt: number;
+  durationMs: number;
+  /** Garbage collections that ran during the frame (`null` without Hermes). */
+  gcs: number | null;
+}
+
+let frameRequest: number | null = null;
+let lastFrameTime = 0;
+let lastGcCount: number | null = null;
+const longFrames: LongFrame[] = [];
+
+function onFrame(time: number): void {
+  const gcCount = readGcCount();
+  if (lastFrameTime > 0) {
+    const duration = time - lastFrameTime;
+    recordHistogram('ui.frame', duration);
+    if (duration > LONG_FRAME_MS) {
+      recordHistogram('ui.frame.long', duration);
+      if (longFrames.length === LONG_FRAME_HISTORY) longFrames.shift();
+      longFrames.push({
+        endedAt: Date.now(),
+        durationMs: duration,
+        gcs: gcCount !== null && lastGcCount !== null ? gcCount - lastGcCount : null,
+      });
+    }
+  }
+  lastFrameTime = time;
+  lastGcCount = gcCount;
+  frameRequest = requestAnimationFrame(onFrame);
+}
+
+/** Start recording frame intervals. Safe to call more than once. */
+export function startFrameMonitor(): void {
+  if (frameRequest !== null) return;
+  lastFrameTime = 0;
+  frameRequest = requestAnimationFrame(onFrame);
+}
+
+/** Stop recording frame intervals. */
+export function stopFrameMonitor(): void {
+  if (frameRequest !== null) cancelAnimationFrame(frameRequest);
+  frameRequest = null;
+  lastFrameTime = 0;
+  lastGcCount = null;
+}
+
+/**
+ * Return the most recent long frames, oldest first. Read by the periodic
+ * diagnostics report (see `services/diagnosticsReport`).
+ */
+export function getLongFrames(): LongFrame[] {
+  return [...longFrames];
+}
+
+/** Forget the recorded long frames (after they have been reported). */
+export function clearLongFrames(): void {
+  longFrames.length = 0;
+}
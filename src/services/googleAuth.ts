@@ -1,4 +1,3 @@
-import { GoogleAuthProvider, type OAuthCredential } from 'firebase/auth';
 import { GOOGLE_OAUTH_CONFIG } from '@/config/env';
 import {
   authenticate,
@@ -69,7 +68,13 @@ async function exchangeCodeForTokens(
 
 // --- Main Public API ---
 
-export async function signInWithGoogleOAuth(): Promise<OAuthCredential | null> {
+/**
+ * Run the Google PKCE OAuth flow in the system browser.
+ *
+ * @returns The Google ID token to exchange with Firebase Auth, or `null` if
+ *   the user cancelled.
+ */
+export async function signInWithGoogleOAuth(): Promise<string | null> {
   const { clientId, reversedClientId } = GOOGLE_OAUTH_CONFIG;
   if (!clientId || !reversedClientId) {
     throw new Error('Google OAuth not configured');
@@ -108,6 +113,5 @@ export async function signInWithGoogleOAuth(): Promise<OAuthCredential | null> {
   }
 
   const tokens = await exchangeCodeForTokens(code, codeVerifier, redirectUri);
-  const credential = GoogleAuthProvider.credential(tokens.id_token);
-  return credential;
+  return tokens.id_token;
 }
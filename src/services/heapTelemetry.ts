@@ -0,0 +1,95 @@
+/**
+ * Hermes heap and GC telemetry
+ *
+ * Samples `HermesInternal.getInstrumentedStats()` on an interval and feeds
+ * the metrics registry:
+ * - gauges `js.heap.size`, `js.heap.allocated`, `js.gc.count`
+ * - gauge `js.alloc.rate` (bytes allocated per second since the last sample)
+ * - histogram `js.gc.pause.mean` (mean GC pause in ms over each interval
+ *   that saw at least one collection; Hermes only reports cumulative GC
+ *   time, so individual pauses, and the worst one, are not visible here)
+ *
+ * Does nothing when the runtime is not Hermes.
+ *
+ * @module services/heapTelemetry
+ */
+
+import { setGauge, recordHistogram } from '@/services/metrics';
+import { scheduleInterval, type TimerHandle } from '@/services/scheduler';
+
+/** Subset of the Hermes instrumented stats this module reads. */
+interface HermesStats {
+  js_heapSize?: number;
+  js_allocatedBytes?: number;
+  js_totalAllocatedBytes?: number;
+  js_numGCs?: number;
+  js_gcTime?: number;
+}
+
+interface HermesInternalType {
+  getInstrumentedStats?: () => HermesStats;
+}
+
+const DEFAULT_INTERVAL_MS = 10 * 1000;
+
+let timer: TimerHandle | null = null;
+let previous: { time: number; totalAllocated: number; gcs: number; gcTime: number } | null = null;
+
+function readStats(): HermesStats | null {
+  const hermes = (globalThis as { HermesInternal?: HermesInternalType }).HermesInternal;
+  return hermes?.getInstrumentedStats?.() ?? null;
+}
+
+/**
+ * The number of garbage collections so far, read directly from Hermes, or
+ * `null` when the runtime is not Hermes.
+ */
+export function readGcCount(): number | null {
+  return readStats()?.js_numGCs ?? null;
+}
+
+function sample(): void {
+  const stats = readStats();
+  if (!stats) return;
+
+  const now = Date.now();
+  const totalAllocated = stats.js_totalAllocatedBytes ?? 0;
+  const gcs = stats.js_numGCs ?? 0;
+  // js_gcTime is reported in seconds.
+  const gcTime = (stats.js_gcTime ?? 0) * 1000;
+
+  setGauge('js.heap.size', stats.js_heapSize ?? 0);
+  setGauge('js.heap.allocated', stats.js_allocatedBytes ?? 0);
+  setGauge('js.gc.count', gcs);
+
+  if (previous) {
+    const elapsed = (now - previous.time) / 1000;
+    if (elapsed > 0) {
+      setGauge('js.alloc.rate', (totalAllocated - previous.totalAllocated) / elapsed);
+    }
+    const newGcs = gcs - previous.gcs;
+    if (newGcs > 0) {
+      // One value per interval, not per collection
+      recordHistogram('js.gc.pause.mean', (gcTime - previous.gcTime) / newGcs);
+    }
+  }
+  previous = { time: now, totalAllocated, gcs, gcTime };
+}
+
+/**
+ * Start sampling heap and GC statistics. Safe to call more than once.
+ *
+ * @param intervalMs - Sampling period (default 10 s).
+ */
+export function startHeapTelemetry(intervalMs: number = DEFAULT_INTERVAL_MS): void {
+  if (timer || !readStats()) return;
+  sample();
+  timer = scheduleInterval(sample, intervalMs, { toleranceMs: intervalMs / 2 });
+}
+
+/** Stop sampling. */
+export function stopHeapTelemetry(): void {
+  timer?.cancel();
+  timer = null;
+  previous = null;
+}
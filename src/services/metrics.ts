@@ -0,0 +1,97 @@
+/**
+ * In-process metrics registry
+ *
+ * A minimal metrics surface for diagnostics collected in JS (heap / GC
+ * telemetry, frame timing, stalls). Gauges hold the latest value; histograms
+ * count observations into fixed exponential buckets so recording is O(1) and
+ * allocation-free. {@link getMetricsSnapshot} returns a serialisable copy
+ * for logging or upload.
+ *
+ * @module services/metrics
+ */
+
+/** Upper bounds of the histogram buckets (values above the last go to overflow). */
+const BUCKET_BOUNDS = [1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096];
+
+/** Serialisable summary of one histogram. */
+export interface HistogramSnapshot {
+  count: number;
+  sum: number;
+  min: number;
+  max: number;
+  /** Observation counts per bucket; `bounds[i]` is the bucket's upper bound. */
+  buckets: number[];
+  bounds: number[];
+}
+
+/** Serialisable copy of every registered metric. */
+export interface MetricsSnapshot {
+  gauges: Record<string, number>;
+  histograms: Record<string, HistogramSnapshot>;
+}
+
+class Histogram {
+  count = 0;
+  sum = 0;
+  min = Infinity;
+  max = -Infinity;
+  readonly buckets = new Array<number>(BUCKET_BOUNDS.length + 1).fill(0);
+
+  record(value: number): void {
+    this.count++;
+    this.sum += value;
+    if (value < this.min) this.min = value;
+    if (value > this.max) this.max = value;
+    let i = 0;
+    while (i < BUCKET_BOUNDS.length && value > BUCKET_BOUNDS[i]) i++;
+    this.buckets[i]++;
+  }
+
+  snapshot(): HistogramSnapshot {
+    return {
+      count: this.count,
+      sum: this.sum,
+      min: this.count > 0 ? this.min : 0,
+      max: this.count > 0 ? this.max : 0,
+      buckets: [...this.buckets],
+      bounds: [...BUCKET_BOUNDS, Infinity],
+    };
+  }
+}
+
+const gauges = new Map<string, number>();
+const histograms = new Map<string, Histogram>();
+
+/** Set a gauge to its latest value. */
+export function setGauge(name: string, value: number): void {
+  gauges.set(name, value);
+}
+
+/** Read a gauge's latest value, or `null` if it was never set. */
+export function getGauge(name: string): number | null {
+  return gauges.get(name) ?? null;
+}
+
+/** Record one observation (typically milliseconds) into a histogram. */
+export function recordHistogram(name: string, value: number): void {
+  let histogram = histograms.get(name);
+  if (!histogram) {
+    histogram = new Histogram();
+    histograms.set(name, histogram);
+  }
+  histogram.record(value);
+}
+
+/** Return a serialisable copy of all gauges and histograms. */
+export function getMetricsSnapshot(): MetricsSnapshot {
+  const snapshot: MetricsSnapshot = { gauges: {}, histograms: {} };
+  for (const [name, value] of gauges) snapshot.gauges[name] = value;
+  for (const [name, histogram] of histograms) snapshot.histograms[name] = histogram.snapshot();
+  return snapshot;
+}
+
+/** Clear all metrics (e.g. after uploading a snapshot). */
+export function resetMetrics(): void {
+  gauges.clear();
+  histograms.clear();
+}
@@ -0,0 +1,106 @@
+/**
+ * Network reachability
+ *
+ * Tracks whether the device is online using the native reachability monitor
+ * (Windows) and lets the rest of the app react to it:
+ * - {@link isOnline} lets background queues hold their uploads.
+ * - {@link shouldFailFast} lets `makeRequest` skip requests instead of
+ *   waiting for a network timeout. The native monitor only reports internet
+ *   access (and can be wrong, e.g. behind some proxies), so this is a hint:
+ *   requests fail fast only after one has actually failed with a network
+ *   error while offline, and only for {@link FAIL_FAST_WINDOW_MS}.
+ * - {@link onReconnect} listeners run once per reconnect, after the link has
+ *   stayed up for {@link RECONNECT_SETTLE_MS}, so a flapping connection
+ *   produces a single sync burst.
+ *
+ * Platforms without a native monitor are always treated as online.
+ *
+ * @module services/reachability
+ */
+
+import { addReachabilityListener, getReachability } from '@/native/Network';
+import { scheduleTimeout, type TimerHandle } from '@/services/scheduler';
+
+/** How long the connection must stay up before reconnect listeners run. */
+const RECONNECT_SETTLE_MS = 2000;
+/** How long a network error seen while offline makes requests fail fast. */
+const FAIL_FAST_WINDOW_MS = 30 * 1000;
+
+type Listener = () => void;
+
+let online = true;
+let started = false;
+/** Epoch ms of the last network error while offline; 0 when none. */
+let lastOfflineErrorAt = 0;
+let pendingReconnect: TimerHandle | null = null;
+const reconnectListeners = new Set<Listener>();
+
+function setOnline(next: boolean): void {
+  const wasOffline = !online;
+  online = next;
+  if (next) lastOfflineErrorAt = 0;
+  if (!next) {
+    pendingReconnect?.cancel();
+    pendingReconnect = null;
+    return;
+  }
+  if (wasOffline && !pendingReconnect) {
+    pendingReconnect = scheduleTimeout(() => {
+      pendingReconnect = null;
+      for (const listener of reconnectListeners) {
+        try {
+          listener();
+        } catch (error) {
+          console.error('[Reachability] Reconnect listener failed:', error);
+        }
+      }
+    }, RECONNECT_SETTLE_MS);
+  }
+}
+
+/** Start tracking reachability. Safe to call more than once. */
+export function startReachabilityMonitor(): void {
+  if (started) return;
+  started = true;
+  addReachabilityListener(setOnline);
+  getReachability()
+    .then((reachable) => {
+      if (reachable !== null) setOnline(reachable);
+    })
+    .catch(() => {});
+}
+
+/** Whether the device is believed to be online. */
+export function isOnline(): boolean {
+  return online;
+}
+
+/**
+ * Record that a request failed without reaching the server. Only counts
+ * while the native monitor reports the device offline.
+ */
+export function reportNetworkError(): void {
+  if (!online) lastOfflineErrorAt = Date.now();
+}
+
+/**
+ * Whether requests to internet hosts should fail immediately: the device is
+ * reported offline and a request has failed with a network error within the
+ * last {@link FAIL_FAST_WINDOW_MS}. Once the window passes, the next request
+ * is tried again.
+ */
+export function shouldFailFast(): boolean {
+  return !online && lastOfflineErrorAt > 0 && Date.now() - lastOfflineErrorAt < FAIL_FAST_WINDOW_MS;
+}
+
+/**
+ * Register a listener that runs once each time connectivity is restored.
+ *
+ * @returns An unsubscribe function.
+ */
+export function onReconnect(listener: Listener): () => void {
+  reconnectListeners.add(listener);
+  return () => {
+    reconnectListeners.delete(listener);
+  };
+}
@@ -0,0 +1,213 @@
+/**
+ * Coalescing timer scheduler
+ *
+ * Runs every periodic JS task (token refresh, future sync / cache timers) off
+ * a single underlying `setTimeout`. Due times are bucketed into fixed-width
+ * slots, and each timer may declare a tolerance: when another timer already
+ * wakes the app within `[deadline, deadline + tolerance]`, the new timer
+ * joins that wake-up instead of creating its own. Fewer distinct wake-ups
+ * lets the OS keep the process idle for longer.
+ *
+ * While the app is hidden, {@link setTimerThrottling} widens every timer's
+ * tolerance so background wake-ups collapse further; clearing it re-slots
+ * pending timers at their original deadlines, so overdue work runs at once.
+ *
+ * @module services/scheduler
+ */
+
+/** Width of one scheduling slot; timers in the same slot fire together. */
+const SLOT_MS = 1000;
+
+/** Options accepted by {@link scheduleTimeout} and {@link scheduleInterval}. */
+export interface ScheduleOptions {
+  /**
+   * How late (in ms) the task may run so it can share a wake-up with other
+   * timers. Defaults to 0 (fire in the slot containing the deadline).
+   */
+  toleranceMs?: number;
+}
+
+/** Handle returned for every scheduled task. */
+export interface TimerHandle {
+  /** Cancel the task. Safe to call more than once. */
+  cancel: () => void;
+}
+
+interface Timer {
+  task: () => void;
+  /** Repeat period in ms, or 0 for a one-shot timer. */
+  intervalMs: number;
+  toleranceMs: number;
+  /** Epoch ms the timer is due; it runs in the first chosen slot at or after this. */
+  deadline: number;
+  slot: number;
+  cancelled: boolean;
+}
+
+const slots = new Map<number, Set<Timer>>();
+let armedSlot = Infinity;
+let armedTimeout: ReturnType<typeof setTimeout> | null = null;
+/** Minimum tolerance applied to every timer while throttled. */
+let throttleToleranceMs = 0;
+let wakeups = 0;
+
+/** Pick the slot for a deadline, preferring an already-occupied slot within tolerance. */
+function chooseSlot(deadline: number, toleranceMs: number): number {
+  const first = Math.ceil(deadline / SLOT_MS);
+  const last = Math.floor((deadline + toleranceMs) / SLOT_MS);
+  for (let slot = first; slot <= last; slot++) {
+    if (slots.has(slot)) return slot;
+  }
+  if (throttleToleranceMs > 0) {
+    // Throttled: snap to a coarse grid so unrelated timers share wake-ups
+    return Math.ceil(Math.ceil(deadline / throttleToleranceMs) * throttleToleranceMs / SLOT_MS);
+  }
+  return first;
+}
+
+function insert(timer: Timer, deadline: number): void {
+  timer.deadline = deadline;
+  timer.slot = chooseSlot(deadline, Math.max(timer.toleranceMs, throttleToleranceMs));
+  let bucket = slots.get(timer.slot);
+  if (!bucket) {
+    bucket = new Set();
+    slots.set(timer.slot, bucket);
+  }
+  bucket.add(timer);
+  if (timer.slot < armedSlot) arm(timer.slot);
+}
+
+function remove(timer: Timer): void {
+  const bucket = slots.get(timer.slot);
+  if (!bucket) return;
+  bucket.delete(timer);
+  if (bucket.size === 0) slots.delete(timer.slot);
+}
+
+/** Arm the single underlying timeout for `slot`. */
+function arm(slot: number): void {
+  if (armedTimeout !== null) clearTimeout(armedTimeout);
+  armedSlot = slot;
+  armedTimeout = setTimeout(tick, Math.max(0, slot * SLOT_MS - Date.now()));
+}
+
+/** Run every timer whose slot has elapsed, then re-arm for the next one. */
+function tick(): void {
+  wakeups++;
+  armedTimeout = null;
+  armedSlot = Infinity;
+  const now = Date.now();
+  const currentSlot = Math.floor(now / SLOT_MS);
+
+  const due: Timer[] = [];
+  for (const [slot, bucket] of slots) {
+    if (slot <= currentSlot) {
+      due.push(...bucket);
+      slots.delete(slot);
+    }
+  }
+
+  for (const timer of due) {
+    if (timer.cancelled) continue;
+    if (timer.intervalMs > 0) insert(timer, now + timer.intervalMs);
+    try {
+      timer.task();
+    } catch (error) {
+      console.error('[Scheduler] Timer task failed:', error);
+    }
+  }
+
+  let next = Infinity;
+  for (const slot of slots.keys()) {
+    if (slot < next) next = slot;
+  }
+  if (next !== Infinity && next < armedSlot) arm(next);
+}
+
+function schedule(task: () => void, delayMs: number, intervalMs: number, options?: ScheduleOptions): TimerHandle {
+  const timer: Timer = {
+    task,
+    intervalMs,
+    toleranceMs: Math.max(0, options?.toleranceMs ?? 0),
+    deadline: 0,
+    slot: 0,
+    cancelled: false,
+  };
+  insert(timer, Date.now() + delayMs);
+  return {
+    cancel: () => {
+      if (timer.cancelled) return;
+      timer.cancelled = true;
+      remove(timer);
+    },
+  };
+}
+
+/**
+ * Run `task` once after `delayMs` (rounded up to the next slot boundary).
+ *
+ * @param task - The function to run.
+ * @param delayMs - Minimum delay before running.
+ * @param options - Optional coalescing tolerance.
+ * @returns A {@link TimerHandle} that cancels the task.
+ */
+export function scheduleTimeout(task: () => void, delayMs: number, options?: ScheduleOptions): TimerHandle {
+  return schedule(task, delayMs, 0, options);
+}
+
+/**
+ * Run `task` every `intervalMs`. Each period is measured from the previous
+ * run, so a late (coalesced) run does not cause a burst of catch-up runs.
+ *
+ * @param task - The function to run.
+ * @param intervalMs - Period between runs; must be positive.
+ * @param options - Optional coalescing tolerance.
+ * @returns A {@link TimerHandle} that cancels the task.
+ *
+ * @example
+ * ```ts
+ * const handle = scheduleInterval(refresh, 50 * 60 * 1000, { toleranceMs: 60 * 1000 });
+ * // later
+ * handle.cancel();
+ * ```
+ */
+export function scheduleInterval(task: () => void, intervalMs: number, options?: ScheduleOptions): TimerHandle {
+  if (intervalMs <= 0) throw new Error('scheduleInterval requires a positive interval');
+  return schedule(task, intervalMs, intervalMs, options);
+}
+
+/**
+ * Apply a minimum coalescing tolerance to every timer (e.g. while the app is
+ * hidden), or pass 0 to restore each timer's own tolerance. Pending timers
+ * are re-slotted immediately.
+ *
+ * @param toleranceMs - Minimum tolerance in ms.
+ */
+export function setTimerThrottling(toleranceMs: number): void {
+  const next = Math.max(0, toleranceMs);
+  if (next === throttleToleranceMs) return;
+  throttleToleranceMs = next;
+
+  const pending: Timer[] = [];
+  for (const bucket of slots.values()) pending.push(...bucket);
+  slots.clear();
+  if (armedTimeout !== null) clearTimeout(armedTimeout);
+  armedTimeout = null;
+  armedSlot = Infinity;
+  for (const timer of pending) insert(timer, timer.deadline);
+}
+
+/** Counters for measuring timer activity. */
+export interface SchedulerStats {
+  /** Underlying timeouts that have fired since start. */
+  wakeups: number;
+  /** Timers currently scheduled. */
+  pending: number;
+}
+
+/** Return current {@link SchedulerStats}. */
+export function getSchedulerStats(): SchedulerStats {
+  let pending = 0;
+  for (const bucket of slots.values()) pending += bucket.size;
+  return { wakeups, pending };
+}
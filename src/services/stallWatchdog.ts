@@ -0,0 +1,58 @@
+/**
+ * JS / UI thread stall watchdog
+ *
+ * A native watchdog thread posts a heartbeat to the JS and UI threads every
+ * few seconds; one that waits longer than the threshold marks its thread as
+ * stalled, and the thread's native stack is sampled into the diagnostic log
+ * file (`%LOCALAPPDATA%\StarterApp\diagnostics.log`) until it recovers, so
+ * a freeze in the field leaves evidence even if the app is killed. Threads
+ * are only suspended for a sample once they have already stalled, so the
+ * watchdog runs in release builds too.
+ *
+ * Each recovered stall is recorded here as histogram `js.stall` or `ui.stall`
+ * (duration in ms), and logged with its stacks in dev mode.
+ *
+ * Windows only; a no-op elsewhere.
+ *
+ * @module services/stallWatchdog
+ */
+
+import { env } from '@/config/env';
+import { addThreadStallListener, startWatchdog, stopWatchdog, type ThreadStall } from '@/native/Watchdog';
+import { recordHistogram } from '@/services/metrics';
+
+const DEFAULT_THRESHOLD_MS = 500;
+
+let unsubscribe: (() => void) | null = null;
+
+function onStall(stall: ThreadStall): void {
+  recordHistogram(`${stall.thread}.stall`, stall.durationMs);
+  if (env.DEV_MODE) {
+    console.warn(
+      `[stallWatchdog] ${stall.thread} thread stalled for ${stall.durationMs}ms`,
+      stall.stacks.join('\n---\n'),
+    );
+  }
+}
+
+/**
+ * Start watching for stalls. Safe to call more than once.
+ *
+ * @param thresholdMs - Heartbeat delay treated as a stall (default 500 ms, minimum 100 ms).
+ */
+export function startStallWatchdog(thresholdMs: number = DEFAULT_THRESHOLD_MS): void {
+  if (unsubscribe) return;
+  unsubscribe = addThreadStallListener(onStall);
+  if (!startWatchdog(thresholdMs)) {
+    unsubscribe();
+    unsubscribe = null;
+  }
+}
+
+/** Stop watching for stalls. */
+export function stopStallWatchdog(): void {
+  if (!unsubscribe) return;
+  stopWatchdog();
+  unsubscribe();
+  unsubscribe = null;
+}
@@ -0,0 +1,299 @@
+/**
+ * Client request tracing
+ *
+ * Creates a client span for each API request and propagates it to the
+ * server with W3C `traceparent` and `tracestate` headers, so slow screens
+ * can be matched with server-side spans. A request made while an active
+ * span is open (see {@link startActiveSpan}, e.g. the `app.startup` span)
+ * joins that span's trace as its child; other requests start their own
+ * trace. Spans of one app launch are also grouped by the `session.id`
+ * resource attribute. The `tracestate` of a trace comes from
+ * `EXPO_PUBLIC_TRACE_STATE` and is inherited by every span in it.
+ *
+ * JavaScript has no async context here, so "active" is global: any request
+ * started while the span is open becomes its child, including unrelated
+ * background ones.
+ *
+ * Each span records time-to-first-byte and download time as attributes,
+ * and these also go into the `http.ttfb` and `http.download` histograms.
+ * Finished spans are buffered and exported in batches to
+ * `EXPO_PUBLIC_TRACES_URL` as OTLP/HTTP JSON, retrying with exponential
+ * backoff. Nothing is exported when no collector is configured.
+ *
+ * @module services/tracing
+ */
+
+import { env } from '@/config/env';
+import { recordHistogram } from '@/services/metrics';
+import { isOnline } from '@/services/reachability';
+import { scheduleTimeout, type TimerHandle } from '@/services/scheduler';
+
+type AttributeValue = string | number | boolean;
+
+/** A finished span, ready for export. */
+export interface SpanData {
+  traceId: string;
+  spanId: string;
+  parentSpanId?: string;
+  name: string;
+  /** `client` for outgoing requests, `internal` for app operations. */
+  kind: 'client' | 'internal';
+  /** Epoch milliseconds. */
+  startTime: number;
+  endTime: number;
+  attributes: Record<string, AttributeValue>;
+  error: boolean;
+}
+
+/** An in-progress span. */
+export interface Span {
+  readonly traceId: string;
+  readonly spanId: string;
+  /** W3C `tracestate` of the trace, if any. */
+  readonly traceState?: string;
+  setAttribute(key: string, value: AttributeValue): void;
+  /** Finish the span; later calls are ignored. */
+  end(options?: { error?: boolean }): void;
+}
+
+/** Finished spans kept while waiting for export; the oldest are dropped. */
+const MAX_BUFFERED_SPANS = 1000;
+const EXPORT_BATCH_SIZE = 200;
+const EXPORT_DELAY_MS = 30 * 1000;
+const MAX_BACKOFF_MS = 30 * 60 * 1000;
+
+const buffer: SpanData[] = [];
+let exportTimer: TimerHandle | null = null;
+let exporting: Promise<void> | null = null;
+let failedExports = 0;
+
+function randomHex(bytes: number): string {
+  let out = '';
+  for (let i = 0; i < bytes; i++) {
+    out += Math.floor(Math.random() * 256).toString(16).padStart(2, '0');
+  }
+  return out;
+}
+
+/** Random non-zero id of `bytes` bytes, as lowercase hex (per W3C trace context). */
+function newId(bytes: number): string {
+  let id = randomHex(bytes);
+  while (/^0+$/.test(id)) id = randomHex(bytes);
+  return id;
+}
+
+/** Identifies this app launch; sent with every export. */
+const sessionId = newId(16);
+
+/** Open active spans, oldest first; request spans parent to the last. */
+const activeSpans: Span[] = [];
+
+/**
+ * Start a span.
+ *
+ * @param name - Span name, e.g. `GET /api/histories`.
+ * @param parent - Parent span; a new trace is started when omitted.
+ * @param kind - `client` for outgoing requests.
+ */
+export function startSpan(name: string, parent: Span | null = null, kind: SpanData['kind'] = 'internal'): Span {
+  const data: SpanData = {
+    traceId: parent?.traceId ?? newId(16),
+    spanId: newId(8),
+    parentSpanId: parent?.spanId,
+    name,
+    kind,
+    startTime: Date.now(),
+    endTime: 0,
+    attributes: {},
+    error: false,
+  };
+  let ended = false;
+  return {
+    traceId: data.traceId,
+    spanId: data.spanId,
+    traceState: parent ? parent.traceState : env.TRACE_STATE || undefined,
+    setAttribute(key, value) {
+      data.attributes[key] = value;
+    },
+    end(options) {
+      if (ended) return;
+      ended = true;
+      data.endTime = Date.now();
+      data.error = options?.error ?? false;
+      record(data);
+    },
+  };
+}
+
+/**
+ * Start a span that requests made until it ends are parented to, such as
+ * app startup or a user interaction. It is itself a child of the span that
+ * was active, and ending it makes that one active again.
+ *
+ * @param name - Span name, e.g. `app.startup`.
+ */
+export function startActiveSpan(name: string): Span {
+  const span = startSpan(name, getActiveSpan());
+  activeSpans.push(span);
+  return {
+    ...span,
+    end(options) {
+      const index = activeSpans.indexOf(span);
+      if (index !== -1) activeSpans.splice(index, 1);
+      span.end(options);
+    },
+  };
+}
+
+/** The span new request spans are currently parented to, or `null`. */
+export function getActiveSpan(): Span | null {
+  return activeSpans[activeSpans.length - 1] ?? null;
+}
+
+/** The id exported as `session.id` with every span of this app launch. */
+export function getSessionId(): string {
+  return sessionId;
+}
+
+/** Format a span as a W3C `traceparent` header value (sampled). */
+export function toTraceparent(span: Span): string {
+  return `00-${span.traceId}-${span.spanId}-01`;
+}
+
+/**
+ * Start a client span for an HTTP request, as a child of the active span
+ * when there is one.
+ *
+ * @returns The span plus the headers to add to the request.
+ */
+export function startRequestSpan(method: string, url: string): { span: Span; headers: Record<string, string> } {
+  const path = url.replace(/^[a-z][a-z0-9+.-]*:\/\/[^/]+/i, '').split('?')[0] || '/';
+  const span = startSpan(`${method} ${path}`, getActiveSpan(), 'client');
+  span.setAttribute('http.request.method', method);
+  span.setAttribute('url.full', url.split('?')[0]);
+  const headers: Record<string, string> = { traceparent: toTraceparent(span) };
+  if (span.traceState) headers.tracestate = span.traceState;
+  return { span, headers };
+}
+
+/**
+ * Record response timings on a request span and end it.
+ *
+ * @param span - The span from {@link startRequestSpan}.
+ * @param status - HTTP status, or 0 when no response was received.
+ * @param timings - Request start, headers received and body read times (epoch ms).
+ */
+export function endRequestSpan(
+  span: Span,
+  status: number,
+  timings: { start: number; headers?: number; end: number }
+): void {
+  span.setAttribute('http.response.status_code', status);
+  if (timings.headers !== undefined) {
+    const ttfb = timings.headers - timings.start;
+    const download = timings.end - timings.headers;
+    span.setAttribute('http.ttfb_ms', ttfb);
+    span.setAttribute('http.download_ms', download);
+    recordHistogram('http.ttfb', ttfb);
+    recordHistogram('http.download', download);
+  }
+  span.end({ error: status === 0 || status >= 500 });
+}
+
+function record(data: SpanData): void {
+  if (!env.TRACES_URL) return;
+  if (buffer.length === MAX_BUFFERED_SPANS) buffer.shift();
+  buffer.push(data);
+  scheduleExport(EXPORT_DELAY_MS);
+}
+
+function scheduleExport(delayMs: number): void {
+  if (exportTimer) return;
+  exportTimer = scheduleTimeout(() => {
+    exportTimer = null;
+    exportSpans().then(
+      () => {
+        failedExports = 0;
+        // Still buffered when offline; try again later
+        if (buffer.length > 0) scheduleExport(EXPORT_DELAY_MS);
+      },
+      (error) => {
+        failedExports++;
+        const backoff = Math.min(EXPORT_DELAY_MS * 2 ** failedExports, MAX_BACKOFF_MS);
+        console.warn(`[Tracing] Export failed, retrying in ${backoff / 1000}s:`, error);
+        scheduleExport(backoff);
+      }
+    );
+  }, delayMs, { toleranceMs: EXPORT_DELAY_MS });
+}
+
+function toOtlpSpan(span: SpanData) {
+  return {
+    traceId: span.traceId,
+    spanId: span.spanId,
+    parentSpanId: span.parentSpanId,
+    name: span.name,
+    kind: span.kind === 'client' ? 3 : 1, // CLIENT : INTERNAL
+    startTimeUnixNano: `${span.startTime}000000`,
+    endTimeUnixNano: `${span.endTime}000000`,
+    attributes: Object.entries(span.attributes).map(([key, value]) => ({
+      key,
+      value:
+        typeof value === 'string'
+          ? { stringValue: value }
+          : typeof value === 'boolean'
+            ? { boolValue: value }
+            : Number.isInteger(value)
+              ? { intValue: value }
+              : { doubleValue: value },
+    })),
+    status: { code: span.error ? 2 : 0 },
+  };
+}
+
+/**
+ * Export buffered spans now. Spans that fail to export go back into the
+ * buffer for the next attempt. A call made while an export is running
+ * joins it rather than sending the same spans again.
+ */
+export function exportSpans(): Promise<void> {
+  if (!exporting) {
+    exporting = sendBuffered().finally(() => {
+      exporting = null;
+    });
+  }
+  return exporting;
+}
+
+async function sendBuffered(): Promise<void> {
+  if (!env.TRACES_URL || !isOnline()) return;
+  while (buffer.length > 0) {
+    // Taken out of the buffer while in flight, so spans recorded (or
+    // dropped for space) meanwhile cannot shift what gets removed
+    const batch = buffer.splice(0, EXPORT_BATCH_SIZE);
+    try {
+      const response = await fetch(env.TRACES_URL, {
+        method: 'POST',
+        headers: { 'Content-Type': 'application/json' },
+        body: JSON.stringify({
+          resourceSpans: [
+            {
+              resource: {
+                attributes: [
+                  { key: 'service.name', value: { stringValue: 'starter-app' } },
+                  { key: 'session.id', value: { stringValue: sessionId } },
+                ],
+              },
+              scopeSpans: [{ scope: { name: 'services/tracing' }, spans: batch.map(toOtlpSpan) }],
+            },
+          ],
+        }),
+      });
+      if (!response.ok) throw new Error(`HTTP ${response.status}`);
+    } catch (error) {
+      buffer.unshift(...batch);
+      if (buffer.length > MAX_BUFFERED_SPANS) buffer.splice(0, buffer.length - MAX_BUFFERED_SPANS);
+      throw error;
+    }
+  }
+}
@@ -0,0 +1,100 @@
+/**
+ * App visibility
+ *
+ * Tracks whether the app is visible to the user, combining React Native's
+ * `AppState` with the native main-window monitor on Windows, where
+ * minimizing the window, or covering it entirely with other windows, does
+ * not change `AppState`. Listeners registered
+ * with {@link onVisibilityChange} are used to throttle timers and pause
+ * non-essential background work while hidden.
+ *
+ * Each hidden period is measured: on return to the foreground the number of
+ * scheduler wake-ups, the process CPU time (where available) and the
+ * duration are recorded into the `app.hidden.wakeups`, `app.hidden.cpu` and
+ * `app.hidden.duration` histograms, so throttling can be verified.
+ *
+ * @module services/visibility
+ */
+
+import { AppState, type AppStateStatus } from 'react-native';
+import { addWindowVisibilityListener, isWindowVisible } from '@/native/Window';
+import { getProcessCpuTime } from '@/native/Diagnostics';
+import { getSchedulerStats } from '@/services/scheduler';
+import { recordHistogram } from '@/services/metrics';
+
+type Listener = (visible: boolean) => void;
+
+let appActive = AppState.currentState !== 'background';
+let windowVisible = true;
+let visible = true;
+let started = false;
+const listeners = new Set<Listener>();
+let hiddenSince: { time: number; wakeups: number; cpu: Promise<number | null> } | null = null;
+
+function update(): void {
+  const next = appActive && windowVisible;
+  if (next === visible) return;
+  visible = next;
+
+  if (!next) {
+    hiddenSince = { time: Date.now(), wakeups: getSchedulerStats().wakeups, cpu: getProcessCpuTime() };
+  } else if (hiddenSince) {
+    const { time, wakeups, cpu } = hiddenSince;
+    hiddenSince = null;
+    recordHistogram('app.hidden.duration', Date.now() - time);
+    recordHistogram('app.hidden.wakeups', getSchedulerStats().wakeups - wakeups);
+    Promise.all([cpu, getProcessCpuTime()])
+      .then(([before, after]) => {
+        if (before !== null && after !== null) recordHistogram('app.hidden.cpu', after - before);
+      })
+      .catch(() => {});
+  }
+
+  for (const listener of listeners) {
+    try {
+      listener(next);
+    } catch (error) {
+      console.error('[Visibility] Listener failed:', error);
+    }
+  }
+}
+
+/** Start tracking visibility. Safe to call more than once. */
+export function startVisibilityMonitor(): void {
+  if (started) return;
+  started = true;
+  AppState.addEventListener('change', (state: AppStateStatus) => {
+    appActive = state !== 'background';
+    update();
+  });
+  addWindowVisibilityListener((shown) => {
+    windowVisible = shown;
+    update();
+  });
+  isWindowVisible()
+    .then((shown) => {
+      if (shown !== null) {
+        windowVisible = shown;
+        update();
+      }
+    })
+    .catch(() => {});
+  update();
+}
+
+/** Whether the app is believed to be visible to the user. */
+export function isAppVisible(): boolean {
+  return visible;
+}
+
+/**
+ * Register a listener that runs whenever the app is hidden or shown again.
+ *
+ * @returns An unsubscribe function.
+ */
+export function onVisibilityChange(listener: Listener): () => void {
+  listeners.add(listener);
+  return () => {
+    listeners.delete(listener);
+  };
+}
@@ -0,0 +1,85 @@
+/**
+ * Tests for the selector-based auth store.
+ *
+ * Counts renders to check that selector consumers only re-render when their
+ * slice changes, and that a published value reaches them in the same act()
+ * as the provider update.
+ */
+
+import React, { memo } from 'react';
+import { act, create } from 'react-test-renderer';
+import type { AuthContextValue } from '@/context/AuthContext';
+import { useAuthSelector, usePublishAuthState } from '../authStore';
+
+const noop = async (): Promise<never> => {
+  throw new Error('not used');
+};
+
+function authValue(overrides: Partial<AuthContextValue>): AuthContextValue {
+  return {
+    user: null,
+    isLoading: false,
+    isReady: true,
+    token: null,
+    signInWithGoogle: noop,
+    signInWithEmail: noop,
+    signUpWithEmail: noop,
+    signOut: noop,
+    sendPasswordResetEmail: noop,
+    refreshToken: noop,
+    ...overrides,
+  };
+}
+
+function Publisher({ value, children }: { value: AuthContextValue; children: React.ReactNode }) {
+  usePublishAuthState(value);
+  return <>{children}</>;
+}
+
+describe('authStore', () => {
+  it('should only re-render selector consumers when their slice changes', () => {
+    const renders: boolean[] = [];
+    const IsReady = memo(function IsReady() {
+      const isReady = useAuthSelector((auth) => auth.isReady);
+      renders.push(isReady);
+      return null;
+    });
+
+    let root!: ReturnType<typeof create>;
+    act(() => {
+      root = create(<Publisher value={authValue({ isLoading: true })}><IsReady /></Publisher>);
+    });
+    // First render sees the store's initial value, then the published one
+    expect(renders).toEqual([false, true]);
+
+    act(() => {
+      root.update(<Publisher value={authValue({ isLoading: false })}><IsReady /></Publisher>);
+    });
+    expect(renders).toEqual([false, true]);
+
+    act(() => {
+      root.update(<Publisher value={authValue({ isReady: false })}><IsReady /></Publisher>);
+    });
+    expect(renders).toEqual([false, true, false]);
+  });
+
+  it('should deliver the published value within the same update', () => {
+    const seen: Array<string | null> = [];
+    const Uid = memo(function Uid() {
+      const uid = useAuthSelector((auth) => auth.user?.uid ?? null);
+      seen.push(uid);
+      return null;
+    });
+    const user = { uid: 'user-1' } as unknown as AuthContextValue['user'];
+
+    let root!: ReturnType<typeof create>;
+    act(() => {
+      root = create(<Publisher value={authValue({})}><Uid /></Publisher>);
+    });
+    act(() => {
+      root.update(<Publisher value={authValue({ user })}><Uid /></Publisher>);
+    });
+    expect(seen[seen.length - 1]).toBe('user-1');
+    act(() => root.unmount());
+  });
+});
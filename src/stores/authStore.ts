@@ -0,0 +1,78 @@
+/**
+ * Auth store - Selector-based view of the auth state
+ *
+ * `AuthProvider` publishes its {@link AuthContextValue} here in addition to
+ * providing it via React context. Components that read the context re-render
+ * whenever *any* field changes (e.g. `isLoading` toggling during a sign-in);
+ * components that read through {@link useAuthSelector} only re-render when
+ * the value returned by their selector changes.
+ *
+ * The store is a mirror, not a second source of truth: it is only written by
+ * `AuthProvider`, in a layout effect, so it catches up before the commit
+ * that changed the context is painted. Within that commit the mirror still
+ * holds the previous value; a component that also reads `useAuth()` or
+ * `useApi()` should take every auth field it compares from that one source.
+ */
+
+import { useLayoutEffect } from 'react';
+import { create } from 'zustand';
+import type { AuthContextValue } from '@/context/AuthContext';
+
+/** Shape of the auth mirror store. */
+interface AuthStoreState {
+  /** The latest value published by `AuthProvider`. */
+  auth: AuthContextValue;
+}
+
+const notMounted = async (): Promise<never> => {
+  throw new Error('AuthProvider is not mounted');
+};
+
+/**
+ * Value seen before `AuthProvider` publishes for the first time; matches the
+ * provider's own initial state (loading, not ready, signed out).
+ */
+const initialAuth: AuthContextValue = {
+  user: null,
+  isLoading: true,
+  isReady: false,
+  token: null,
+  signInWithGoogle: notMounted,
+  signInWithEmail: notMounted,
+  signUpWithEmail: notMounted,
+  signOut: notMounted,
+  sendPasswordResetEmail: notMounted,
+  refreshToken: notMounted,
+};
+
+const useAuthStore = create<AuthStoreState>()(() => ({ auth: initialAuth }));
+
+/**
+ * Publish the provider's current value. Called by `AuthProvider` only.
+ *
+ * Runs in a layout effect so subscribers re-render before the frame is
+ * painted, rather than one passive-effect flush later.
+ *
+ * @param auth - The memoised context value.
+ */
+export function usePublishAuthState(auth: AuthContextValue): void {
+  useLayoutEffect(() => {
+    useAuthStore.setState({ auth });
+  }, [auth]);
+}
+
+/**
+ * Subscribe to a slice of the auth state.
+ *
+ * Selectors must return a primitive or a reference that is stable while the
+ * underlying fields are unchanged (e.g. `auth.user`, `auth.signOut`), since
+ * results are compared with `Object.is`.
+ *
+ * @example
+ * ```ts
+ * const isReady = useAuthSelector((auth) => auth.isReady);
+ * ```
+ */
+export function useAuthSelector<T>(selector: (auth: AuthContextValue) => T): T {
+  return useAuthStore((state) => selector(state.auth));
+}
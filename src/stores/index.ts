@@ -1 +1,2 @@
 export { useSettingsStore, type ThemeMode } from './settingsStore';
+export { useAuthSelector } from './authStore';
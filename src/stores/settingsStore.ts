@@ -35,9 +35,13 @@ const initialState = {
  * Settings are automatically persisted to AsyncStorage under the key
  * `'starter-settings'` and rehydrated on app launch.
  *
+ * Prefer selecting individual fields so a component only re-renders when the
+ * fields it reads change.
+ *
  * @example
  * ```ts
- * const { theme, setTheme } = useSettingsStore();
+ * const theme = useSettingsStore((state) => state.theme);
+ * const setTheme = useSettingsStore((state) => state.setTheme);
  * setTheme('dark');
  * ```
  */
@@ -0,0 +1,64 @@
+/**
+ * Tests for columnar history aggregation.
+ *
+ * Verifies that the sliced builder produces the same columns as the
+ * synchronous one, actually yields on large inputs, and honours aborts.
+ */
+
+import type { History } from '@sudobility/superguide_types';
+import { buildHistoryColumns, buildHistoryColumnsSliced } from '../historyColumns';
+
+function makeHistories(count: number): History[] {
+  const histories: History[] = [];
+  for (let i = 0; i < count; i++) {
+    histories.push({
+      id: `h${i}`,
+      datetime: new Date(Date.UTC(2024, 0, 1) + i * 60000).toISOString(),
+      value: (i % 10) + 0.5,
+    } as History);
+  }
+  return histories;
+}
+
+describe('buildHistoryColumns', () => {
+  it('should compute timestamps, values and total', () => {
+    const columns = buildHistoryColumns(makeHistories(3));
+    expect(Array.from(columns.values)).toEqual([0.5, 1.5, 2.5]);
+    expect(columns.total).toBe(4.5);
+    expect(columns.timestamps[1]).toBe(Date.UTC(2024, 0, 1, 0, 1));
+  });
+
+  it('should store NaN for unparseable datetimes', () => {
+    const columns = buildHistoryColumns([{ id: 'x', datetime: 'nope', value: 1 } as History]);
+    expect(Number.isNaN(columns.timestamps[0])).toBe(true);
+  });
+});
+
+describe('buildHistoryColumnsSliced', () => {
+  it('should match the synchronous result', async () => {
+    const histories = makeHistories(5000);
+    const expected = buildHistoryColumns(histories);
+    const actual = await buildHistoryColumnsSliced(histories, { budgetMs: 0 });
+    expect(actual.total).toBe(expected.total);
+    expect(actual.timestamps).toEqual(expected.timestamps);
+    expect(actual.values).toEqual(expected.values);
+  });
+
+  it('should yield between slices', async () => {
+    let ticks = 0;
+    const interval = setInterval(() => ticks++, 0);
+    await buildHistoryColumnsSliced(makeHistories(5000), { budgetMs: 0 });
+    clearInterval(interval);
+    expect(ticks).toBeGreaterThan(0);
+  });
+
+  it('should reject when aborted', async () => {
+    const controller = new AbortController();
+    const promise = buildHistoryColumnsSliced(makeHistories(5000), {
+      budgetMs: 0,
+      signal: controller.signal,
+    });
+    controller.abort();
+    await expect(promise).rejects.toMatchObject({ name: 'AbortError' });
+  });
+});
@@ -0,0 +1,54 @@
+/**
+ * Tests for history lookup by id.
+ *
+ * Verifies that lookups match `Array.find` (including repeated ids), and
+ * that the index is built once per array and rebuilt for a new one.
+ */
+
+import type { History } from '@sudobility/superguide_types';
+import { findHistory, getHistoryIndex, historyKey } from '../historyIndex';
+
+function makeHistory(id: string, value: number): History {
+  return { id, datetime: '2024-01-01T00:00:00.000Z', value } as History;
+}
+
+describe('findHistory', () => {
+  const histories = [makeHistory('a', 1), makeHistory('b', 2), makeHistory('c', 3)];
+
+  it('should find entries by id', () => {
+    expect(findHistory(histories, 'b')).toBe(histories[1]);
+    expect(findHistory(histories, 'c')).toBe(histories[2]);
+  });
+
+  it('should return undefined for unknown ids and empty lists', () => {
+    expect(findHistory(histories, 'z')).toBeUndefined();
+    expect(findHistory([], 'a')).toBeUndefined();
+  });
+
+  it('should return the first entry for a repeated id, like Array.find', () => {
+    const repeated = [makeHistory('a', 1), makeHistory('a', 2)];
+    expect(findHistory(repeated, 'a')).toBe(repeated.find((h) => h.id === 'a'));
+    expect(findHistory(repeated, 'a')?.value).toBe(1);
+  });
+});
+
+describe('getHistoryIndex', () => {
+  it('should build the index once per array', () => {
+    const histories = [makeHistory('a', 1)];
+    expect(getHistoryIndex(histories)).toBe(getHistoryIndex(histories));
+  });
+
+  it('should build a new index for a new array', () => {
+    const before = [makeHistory('a', 1)];
+    const after = [...before, makeHistory('b', 2)];
+    expect(getHistoryIndex(after)).not.toBe(getHistoryIndex(before));
+    expect(findHistory(after, 'b')).toBe(after[1]);
+    expect(findHistory(before, 'b')).toBeUndefined();
+  });
+});
+
+describe('historyKey', () => {
+  it('should key rows by id', () => {
+    expect(historyKey(makeHistory('a', 1))).toBe('a');
+  });
+});
@@ -0,0 +1,24 @@
+/**
+ * Tests for request body serialisation.
+ */
+
+import { serializeBody } from '../requestBody';
+
+describe('serializeBody', () => {
+  it('should send no body for null and undefined', () => {
+    expect(serializeBody(undefined)).toBeUndefined();
+    expect(serializeBody(null)).toBeUndefined();
+  });
+
+  it('should JSON-encode objects and falsy values', () => {
+    expect(serializeBody({ a: 1, b: [true] })).toBe('{"a":1,"b":[true]}');
+    expect(serializeBody(0)).toBe('0');
+    expect(serializeBody(false)).toBe('false');
+  });
+
+  it('should JSON-encode strings rather than send them raw', () => {
+    expect(serializeBody('hello')).toBe('"hello"');
+    expect(serializeBody('')).toBe('""');
+    expect(serializeBody('{"a":1}')).toBe('"{\\"a\\":1}"');
+  });
+});
@@ -0,0 +1,107 @@
+/**
+ * Tests for the strict ISO-8601 timestamp parser.
+ *
+ * Verifies that accepted forms agree with `Date.parse`, that malformed or
+ * out-of-range timestamps are rejected, and fuzzes the parser with random
+ * timestamps and random single-character mutations.
+ */
+
+import { parseIsoTimestamp, parseIsoTimestamps, toDate } from '../timestamps';
+
+/** Small deterministic PRNG so fuzz failures are reproducible. */
+function createRandom(seed: number): () => number {
+  let state = seed >>> 0;
+  return () => {
+    state = (state * 1664525 + 1013904223) >>> 0;
+    return state / 0x100000000;
+  };
+}
+
+describe('parseIsoTimestamp', () => {
+  it('should parse UTC timestamps with milliseconds', () => {
+    expect(parseIsoTimestamp('2024-05-01T12:30:15.250Z')).toBe(Date.UTC(2024, 4, 1, 12, 30, 15, 250));
+  });
+
+  it('should parse date-only values as UTC midnight', () => {
+    expect(parseIsoTimestamp('2024-02-29')).toBe(Date.UTC(2024, 1, 29));
+  });
+
+  it('should apply numeric offsets', () => {
+    expect(parseIsoTimestamp('2024-01-01T05:30:00+05:30')).toBe(Date.UTC(2024, 0, 1));
+    expect(parseIsoTimestamp('2023-12-31T16:00:00-0800')).toBe(Date.UTC(2024, 0, 1));
+    expect(parseIsoTimestamp('2024-01-01 01:00:00+01')).toBe(Date.UTC(2024, 0, 1));
+  });
+
+  it('should treat date-times without a designator as local time', () => {
+    expect(parseIsoTimestamp('2024-03-10T08:15')).toBe(new Date(2024, 2, 10, 8, 15).getTime());
+  });
+
+  it('should truncate fractions beyond millisecond precision', () => {
+    expect(parseIsoTimestamp('2024-01-01T00:00:00.123999Z')).toBe(Date.UTC(2024, 0, 1, 0, 0, 0, 123));
+  });
+
+  it.each([
+    '',
+    '2024',
+    '2024-1-01',
+    '2024-02-30',
+    '2023-02-29',
+    '2024-13-01',
+    '2024-01-01T',
+    '2024-01-01T24:00',
+    '2024-01-01T12:60',
+    '2024-01-01T12:00:60Z',
+    '2024-01-01T12:00:00.Z',
+    '2024-01-01T12:00:00ZZ',
+    '2024-01-01T12:00:00+24:00',
+    '2024-01-01T12:00:00+05:3',
+    '2024-01-01X12:00:00Z',
+    'not a date',
+  ])('should reject %p', (value) => {
+    expect(parseIsoTimestamp(value)).toBeNaN();
+  });
+
+  it('should agree with Date.parse on random valid timestamps', () => {
+    const random = createRandom(76);
+    const offsets = ['Z', '+00:00', '+05:30', '-08:00', '+1245'];
+    for (let i = 0; i < 5000; i++) {
+      const ms = Math.floor(random() * 4102444800000); // 1970 .. 2100
+      const iso = new Date(ms).toISOString();
+      const value = iso.slice(0, -1) + offsets[Math.floor(random() * offsets.length)];
+      expect(parseIsoTimestamp(value)).toBe(Date.parse(value));
+    }
+  });
+
+  it('should never accept a mutated timestamp that Date.parse reads differently', () => {
+    const random = createRandom(77);
+    const alphabet = '0123456789-:.TZ+ x';
+    const base = '2024-07-15T09:45:30.125+02:00';
+    for (let i = 0; i < 5000; i++) {
+      const position = Math.floor(random() * base.length);
+      const replacement = alphabet[Math.floor(random() * alphabet.length)];
+      const value = base.slice(0, position) + replacement + base.slice(position + 1);
+      const parsed = parseIsoTimestamp(value);
+      if (!Number.isNaN(parsed)) {
+        expect(parsed).toBe(Date.parse(value));
+      }
+    }
+  });
+});
+
+describe('parseIsoTimestamps', () => {
+  it('should return an index-aligned column with NaN for invalid entries', () => {
+    const column = parseIsoTimestamps(['2024-01-01T00:00:00Z', 'bogus', '1970-01-01']);
+    expect(column).toBeInstanceOf(Float64Array);
+    expect(column.length).toBe(3);
+    expect(column[0]).toBe(Date.UTC(2024, 0, 1));
+    expect(column[1]).toBeNaN();
+    expect(column[2]).toBe(0);
+  });
+});
+
+describe('toDate', () => {
+  it('should fall back to the engine parser for non-ISO strings', () => {
+    const value = 'Mon, 01 Jan 2024 00:00:00 GMT';
+    expect(toDate(value).getTime()).toBe(Date.parse(value));
+  });
+});
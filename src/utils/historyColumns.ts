@@ -0,0 +1,100 @@
+/**
+ * Columnar history aggregation
+ *
+ * Screens need the same derived data from a histories response: the user's
+ * total and each entry's timestamp. These helpers compute them in a single
+ * pass into typed-array columns. Large responses are processed in short time
+ * slices that yield back to the event loop between slices, so aggregation
+ * never holds the JS thread for longer than one frame's budget.
+ *
+ * @module utils/historyColumns
+ */
+
+import type { History } from '@sudobility/superguide_types';
+import { parseIsoTimestamp } from '@/utils/timestamps';
+
+/** Derived per-entry columns plus aggregates, index-aligned with the input. */
+export interface HistoryColumns {
+  /** Epoch milliseconds for each entry's `datetime`, `NaN` when unparseable. */
+  timestamps: Float64Array;
+  /** Each entry's `value`. */
+  values: Float64Array;
+  /** Sum of all values. */
+  total: number;
+}
+
+/** Options for {@link buildHistoryColumnsSliced}. */
+export interface SliceOptions {
+  /** Maximum time (ms) to spend before yielding. Defaults to 8. */
+  budgetMs?: number;
+  /** Stop early; the returned promise then rejects with an `AbortError`. */
+  signal?: AbortSignal;
+}
+
+/** Entries processed between clock checks. */
+const CHECK_INTERVAL = 256;
+
+function allocate(length: number): HistoryColumns {
+  return { timestamps: new Float64Array(length), values: new Float64Array(length), total: 0 };
+}
+
+/** Fill `columns` for entries `[start, end)` and return the partial sum. */
+function fill(histories: readonly History[], columns: HistoryColumns, start: number, end: number): number {
+  let sum = 0;
+  for (let i = start; i < end; i++) {
+    const history = histories[i];
+    columns.timestamps[i] = parseIsoTimestamp(history.datetime);
+    columns.values[i] = history.value;
+    sum += history.value;
+  }
+  return sum;
+}
+
+/**
+ * Compute {@link HistoryColumns} synchronously.
+ *
+ * @param histories - Entries from `useHistoriesManager`.
+ * @returns The derived columns.
+ */
+export function buildHistoryColumns(histories: readonly History[]): HistoryColumns {
+  const columns = allocate(histories.length);
+  columns.total = fill(histories, columns, 0, histories.length);
+  return columns;
+}
+
+/**
+ * Compute {@link HistoryColumns} in time slices, yielding to the event loop
+ * whenever `budgetMs` is used up so rendering and input stay responsive.
+ *
+ * @param histories - Entries from `useHistoriesManager`.
+ * @param options - Slice budget and optional abort signal.
+ * @returns A promise for the same result as {@link buildHistoryColumns}.
+ */
+export async function buildHistoryColumnsSliced(
+  histories: readonly History[],
+  options?: SliceOptions
+): Promise<HistoryColumns> {
+  const budgetMs = options?.budgetMs ?? 8;
+  const signal = options?.signal;
+  const columns = allocate(histories.length);
+
+  let index = 0;
+  while (index < histories.length) {
+    if (signal?.aborted) {
+      const error = new Error('History aggregation aborted');
+      error.name = 'AbortError';
+      throw error;
+    }
+    const sliceStart = Date.now();
+    do {
+      const end = Math.min(index + CHECK_INTERVAL, histories.length);
+      columns.total += fill(histories, columns, index, end);
+      index = end;
+    } while (index < histories.length && Date.now() - sliceStart < budgetMs);
+
+    if (index < histories.length) {
+      await new Promise<void>((resolve) => setTimeout(resolve, 0));
+    }
+  }
+  return columns;
+}
@@ -0,0 +1,46 @@
+/**
+ * History lookup by id
+ *
+ * Several screens resolve a `historyId` (from navigation params) against the
+ * same `histories` array. {@link findHistory} builds an id → entry index
+ * once per array and caches it in a `WeakMap` keyed by that array, so each
+ * lookup is O(1). The index is freed together with the array.
+ *
+ * @module utils/historyIndex
+ */
+
+import type { History } from '@sudobility/superguide_types';
+
+const indexes = new WeakMap<readonly History[], Map<string, History>>();
+
+/**
+ * Return the id → entry index for `histories`, building it on first use.
+ *
+ * @param histories - Entries from `useHistoriesManager`.
+ */
+export function getHistoryIndex(histories: readonly History[]): ReadonlyMap<string, History> {
+  let index = indexes.get(histories);
+  if (!index) {
+    index = new Map();
+    // Keep the first entry for a repeated id, as `Array.find` would
+    for (const history of histories) {
+      if (!index.has(history.id)) index.set(history.id, history);
+    }
+    indexes.set(histories, index);
+  }
+  return index;
+}
+
+/**
+ * Find the entry with `id` in `histories`.
+ *
+ * @returns The entry, or `undefined` if there is none.
+ */
+export function findHistory(histories: readonly History[], id: string): History | undefined {
+  return getHistoryIndex(histories).get(id);
+}
+
+/** Stable `FlatList` key extractor for history rows. */
+export function historyKey(history: History): string {
+  return history.id;
+}
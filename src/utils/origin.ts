@@ -0,0 +1,88 @@
+/**
+ * URL origin comparison
+ *
+ * Decides whether a request URL goes to the same server as a base URL, for
+ * attaching credentials and trace headers, and whether it targets a local
+ * or private-network host, and extracts hosts for DNS prefetching. Parsed by hand because React Native's `URL` does
+ * not implement `host` / `origin`.
+ *
+ * @module utils/origin
+ */
+
+const DEFAULT_PORTS: Record<string, string> = { http: '80', https: '443' };
+
+interface ParsedAuthority {
+  scheme: string;
+  host: string;
+  port: string;
+}
+
+/**
+ * Split an absolute http(s) URL into lower-cased scheme and host and an
+ * explicit port. `null` for relative, non-http(s) or malformed URLs and URLs
+ * with user info (`http://api@evil.example`).
+ */
+function parseAuthority(url: string): ParsedAuthority | null {
+  const match = /^(https?):\/\/([^/?#\\]*)(?:[/?#]|$)/i.exec(url);
+  if (!match) return null;
+  const scheme = match[1].toLowerCase();
+  const authority = /^(\[[0-9a-f:.]+\]|[^:@[\]]+)(?::(\d*))?$/i.exec(match[2]);
+  if (!authority) return null;
+  return {
+    scheme,
+    host: authority[1].toLowerCase(),
+    port: authority[2] || DEFAULT_PORTS[scheme],
+  };
+}
+
+/**
+ * The `scheme://host:port` origin of an absolute http(s) URL, lower-cased and
+ * with the default port made explicit.
+ *
+ * @returns The origin, or `null` for relative, non-http(s) or malformed URLs
+ *   and URLs with user info.
+ */
+export function originOf(url: string): string | null {
+  const parsed = parseAuthority(url);
+  return parsed ? `${parsed.scheme}://${parsed.host}:${parsed.port}` : null;
+}
+
+/**
+ * The lower-cased host of an absolute http(s) URL (IPv6 literals keep their
+ * brackets), e.g. for DNS prefetching.
+ *
+ * @returns The host, or `null` where {@link originOf} would return `null`.
+ */
+export function hostOf(url: string): string | null {
+  return parseAuthority(url)?.host ?? null;
+}
+
+/**
+ * Whether `url` has exactly the same origin as `baseUrl`. Always `false`
+ * when `baseUrl` is empty or not an absolute http(s) URL.
+ */
+export function isSameOrigin(url: string, baseUrl: string): boolean {
+  const base = originOf(baseUrl);
+  return base !== null && originOf(url) === base;
+}
+
+/**
+ * Whether `url` targets a loopback, link-local or private-network host
+ * (`localhost`, `*.local`, 127/8, 10/8, 172.16/12, 192.168/16, 169.254/16,
+ * `::1`, `fc00::/7`, `fe80::/10`), which stays reachable when the machine
+ * has no internet access.
+ */
+export function isLocalUrl(url: string): boolean {
+  const host = parseAuthority(url)?.host;
+  if (!host) return false;
+  if (host === 'localhost' || host.endsWith('.localhost') || host.endsWith('.local')) return true;
+  if (host.startsWith('[')) {
+    const ip = host.slice(1, -1);
+    return ip === '::1' || /^f[cd][0-9a-f]{2}:/.test(ip) || /^fe[89ab][0-9a-f]:/.test(ip);
+  }
+  const octets = /^(\d+)\.(\d+)\.\d+\.\d+$/.exec(host);
+  if (!octets) return false;
+  const a = Number(octets[1]);
+  const b = Number(octets[2]);
+  return a === 127 || a === 10 || (a === 172 && b >= 16 && b <= 31) || (a === 192 && b === 168) || (a === 169 && b === 254);
+}
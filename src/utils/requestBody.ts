@@ -0,0 +1,24 @@
+/**
+ * Request body serialisation
+ *
+ * Turns the `body` argument of `NetworkClient.post` / `put` into the string
+ * sent over the wire. Every value, strings included, is JSON-encoded, as
+ * the `@sudobility/types` contract expects.
+ *
+ * @module utils/requestBody
+ */
+
+/**
+ * Serialise a `POST` / `PUT` body.
+ *
+ * Only `null` and `undefined` mean "no body"; other falsy values such as
+ * `0`, `false` or `''` are valid JSON documents and are serialised. Strings
+ * are JSON-encoded like any other value.
+ *
+ * @param body - The request body supplied by the caller.
+ * @returns The JSON string to send, or `undefined` for no body.
+ */
+export function serializeBody(body: unknown): string | undefined {
+  if (body === undefined || body === null) return undefined;
+  return JSON.stringify(body);
+}
@@ -0,0 +1,179 @@
+/**
+ * Strict ISO-8601 timestamp parsing
+ *
+ * History records carry their `datetime` / `created_at` fields as ISO-8601
+ * strings. Parsing them with `new Date(string)` on every render goes through
+ * the engine's lenient, locale-aware date parser each time. These helpers
+ * parse the strict subset the API emits directly from char codes and can
+ * decode a whole response into a `Float64Array` column of epoch milliseconds
+ * in one pass, so screens parse each timestamp once per data change.
+ *
+ * Accepted forms (ECMAScript date-time semantics):
+ * - `YYYY-MM-DD` (UTC)
+ * - `YYYY-MM-DDTHH:mm[:ss[.fraction]]` (local time)
+ * - the above followed by `Z`, `±HH:mm`, `±HHmm` or `±HH`
+ *
+ * A space is accepted in place of `T`. Anything else (including out-of-range
+ * fields such as `2024-02-30`) is rejected with `NaN`.
+ *
+ * @module utils/timestamps
+ */
+
+const MS_PER_MINUTE = 60 * 1000;
+const MS_PER_DAY = 24 * 60 * MS_PER_MINUTE;
+
+/** Read one ASCII digit at `index`, or -1 when it is not a digit. */
+function digitAt(value: string, index: number): number {
+  const d = value.charCodeAt(index) - 48;
+  return d >= 0 && d <= 9 ? d : -1;
+}
+
+/** Read a fixed-width unsigned decimal field, or -1 on any non-digit. */
+function fieldAt(value: string, index: number, width: number): number {
+  let result = 0;
+  for (let i = 0; i < width; i++) {
+    const d = digitAt(value, index + i);
+    if (d < 0) return -1;
+    result = result * 10 + d;
+  }
+  return result;
+}
+
+function isLeapYear(year: number): boolean {
+  return (year % 4 === 0 && year % 100 !== 0) || year % 400 === 0;
+}
+
+function daysInMonth(year: number, month: number): number {
+  if (month === 2) return isLeapYear(year) ? 29 : 28;
+  return month === 4 || month === 6 || month === 9 || month === 11 ? 30 : 31;
+}
+
+/**
+ * Days since 1970-01-01 for a proleptic Gregorian civil date
+ * (H. Hinnant's `days_from_civil`).
+ */
+function daysFromCivil(year: number, month: number, day: number): number {
+  const y = month <= 2 ? year - 1 : year;
+  const era = Math.floor(y / 400);
+  const yoe = y - era * 400;
+  const mp = (month + 9) % 12;
+  const doy = Math.floor((153 * mp + 2) / 5) + day - 1;
+  const doe = yoe * 365 + Math.floor(yoe / 4) - Math.floor(yoe / 100) + doy;
+  return era * 146097 + doe - 719468;
+}
+
+/**
+ * Parse a single ISO-8601 timestamp into epoch milliseconds.
+ *
+ * @param value - The timestamp string, e.g. `2024-05-01T12:30:00.000Z`.
+ * @returns Milliseconds since the Unix epoch, or `NaN` if `value` is not a
+ *   valid timestamp in the accepted subset.
+ */
+export function parseIsoTimestamp(value: string): number {
+  const length = value.length;
+  if (length < 10 || value.charCodeAt(4) !== 45 || value.charCodeAt(7) !== 45) {
+    return NaN;
+  }
+
+  const year = fieldAt(value, 0, 4);
+  const month = fieldAt(value, 5, 2);
+  const day = fieldAt(value, 8, 2);
+  if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+    return NaN;
+  }
+
+  const dayMs = daysFromCivil(year, month, day) * MS_PER_DAY;
+  if (length === 10) return dayMs;
+
+  // Time part: [T ]HH:mm[:ss[.fraction]]
+  const separator = value.charCodeAt(10);
+  if ((separator !== 84 && separator !== 32) || length < 16 || value.charCodeAt(13) !== 58) {
+    return NaN;
+  }
+  const hour = fieldAt(value, 11, 2);
+  const minute = fieldAt(value, 14, 2);
+  if (hour < 0 || hour > 23 || minute < 0 || minute > 59) return NaN;
+
+  let second = 0;
+  let millis = 0;
+  let i = 16;
+  if (i < length && value.charCodeAt(i) === 58) {
+    second = fieldAt(value, i + 1, 2);
+    if (second < 0 || second > 59) return NaN;
+    i += 3;
+    if (i < length && value.charCodeAt(i) === 46) {
+      i++;
+      const fractionStart = i;
+      let scale = 100;
+      while (i < length) {
+        const d = digitAt(value, i);
+        if (d < 0) break;
+        millis += d * scale;
+        scale /= 10;
+        i++;
+      }
+      if (i === fractionStart) return NaN;
+      millis = Math.floor(millis);
+    }
+  }
+
+  const timeMs = ((hour * 60 + minute) * 60 + second) * 1000 + millis;
+
+  // No designator: local time, as `Date` does for date-time forms.
+  if (i === length) {
+    const local = new Date(year, month - 1, day, hour, minute, second, millis);
+    if (year < 100) local.setFullYear(year);
+    return local.getTime();
+  }
+
+  const designator = value.charCodeAt(i);
+  if (designator === 90) {
+    return i + 1 === length ? dayMs + timeMs : NaN;
+  }
+  if (designator !== 43 && designator !== 45) return NaN;
+
+  const offsetHours = fieldAt(value, i + 1, 2);
+  let offsetMinutes = 0;
+  let end = i + 3;
+  if (end < length) {
+    if (value.charCodeAt(end) === 58) end++;
+    offsetMinutes = fieldAt(value, end, 2);
+    end += 2;
+  }
+  if (end !== length || offsetHours < 0 || offsetHours > 23 || offsetMinutes < 0 || offsetMinutes > 59) {
+    return NaN;
+  }
+
+  const offsetMs = (offsetHours * 60 + offsetMinutes) * MS_PER_MINUTE;
+  return dayMs + timeMs + (designator === 43 ? -offsetMs : offsetMs);
+}
+
+/**
+ * Parse a batch of ISO-8601 timestamps into a column of epoch milliseconds.
+ *
+ * Invalid entries are stored as `NaN` so the column stays index-aligned with
+ * the input array.
+ *
+ * @param values - Timestamp strings, typically `histories.map(h => h.datetime)`.
+ * @returns A `Float64Array` with one entry per input string.
+ */
+export function parseIsoTimestamps(values: readonly string[]): Float64Array {
+  const column = new Float64Array(values.length);
+  for (let i = 0; i < values.length; i++) {
+    column[i] = parseIsoTimestamp(values[i]);
+  }
+  return column;
+}
+
+/**
+ * Convert a timestamp to a `Date`, using the strict parser as a fast path for
+ * strings and falling back to the `Date` constructor for anything it rejects.
+ *
+ * @param value - The timestamp string (or an existing epoch / `Date`).
+ * @returns The parsed `Date` (which may be an invalid date).
+ */
+export function toDate(value: string | number | Date): Date {
+  if (typeof value !== 'string') return new Date(value);
+  const ms = parseIsoTimestamp(value);
+  return new Date(Number.isNaN(ms) ? value : ms);
+}
@@ -0,0 +1,155 @@
+#include "AuthFlow.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using StarterApp::AuthUiResult;
+using StarterApp::IAuthUiBackend;
+using StarterApp::RunAuthentication;
+
+namespace {
+
+// Headless stand-in for the browser backends: returns a scripted result,
+// or with `waitForCancel` blocks until Cancel() as the protocol backend does.
+class FakeAuthUiBackend final : public IAuthUiBackend {
+ public:
+  explicit FakeAuthUiBackend(AuthUiResult result, bool waitForCancel = false)
+      : m_result(std::move(result)), m_waitForCancel(waitForCancel) {}
+
+  const char *Name() const noexcept override { return "fake"; }
+
+  AuthUiResult Authenticate(const std::string &url,
+                            const std::string &callbackScheme) override {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_url = url;
+    m_scheme = callbackScheme;
+    m_started = true;
+    m_changed.notify_all();
+    if (!m_waitForCancel)
+      return m_result;
+    // Bounded so a broken Cancel fails the test instead of hanging it.
+    if (!m_changed.wait_for(lock, std::chrono::seconds(10),
+                            [this] { return m_cancelled; }))
+      return AuthUiResult::Error("TIMEOUT", "Cancel() never arrived");
+    return AuthUiResult::Cancelled();
+  }
+
+  void Cancel() noexcept override {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancelled = true;
+    m_changed.notify_all();
+  }
+
+  void WaitUntilStarted() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait_for(lock, std::chrono::seconds(10),
+                       [this] { return m_started; });
+  }
+
+  std::string m_url;
+  std::string m_scheme;
+
+ private:
+  AuthUiResult m_result;
+  bool m_waitForCancel;
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  bool m_started{false};
+  bool m_cancelled{false};
+};
+
+// What the promise was settled with.
+struct Settled {
+  int resolves{0};
+  int rejects{0};
+  std::optional<std::string> value;
+  std::string code;
+  std::string message;
+};
+
+StarterApp::AuthAttempt SignIn(IAuthUiBackend &backend, Settled &settled) {
+  return RunAuthentication(
+      backend, "https://accounts.example.com/auth", "com.example.app",
+      [&](std::optional<std::string> value) {
+        settled.resolves++;
+        settled.value = std::move(value);
+      },
+      [&](std::string code, std::string message) {
+        settled.rejects++;
+        settled.code = std::move(code);
+        settled.message = std::move(message);
+      });
+}
+
+TEST(AuthFlow, ResolvesWithTheCallbackUrl) {
+  AuthUiResult result;
+  result.callbackUrl = "com.example.app://callback?code=abc";
+  FakeAuthUiBackend backend{std::move(result)};
+  Settled settled;
+  auto attempt = SignIn(backend, settled);
+
+  EXPECT_STREQ(attempt.outcome, "success");
+  EXPECT_EQ(settled.resolves, 1);
+  EXPECT_EQ(settled.rejects, 0);
+  EXPECT_EQ(settled.value, "com.example.app://callback?code=abc");
+  EXPECT_EQ(backend.m_url, "https://accounts.example.com/auth");
+  EXPECT_EQ(backend.m_scheme, "com.example.app");
+}
+
+TEST(AuthFlow, ResolvesNullWhenCancelled) {
+  FakeAuthUiBackend backend{AuthUiResult::Cancelled()};
+  Settled settled;
+  auto attempt = SignIn(backend, settled);
+
+  EXPECT_STREQ(attempt.outcome, "cancelled");
+  EXPECT_EQ(settled.resolves, 1);
+  EXPECT_EQ(settled.value, std::nullopt);
+}
+
+TEST(AuthFlow, RejectsWithTheBackendError) {
+  FakeAuthUiBackend backend{
+      AuthUiResult::Error("TIMEOUT", "No callback received")};
+  Settled settled;
+  auto attempt = SignIn(backend, settled);
+
+  EXPECT_STREQ(attempt.outcome, "error");
+  EXPECT_EQ(settled.resolves, 0);
+  EXPECT_EQ(settled.rejects, 1);
+  EXPECT_EQ(settled.code, "TIMEOUT");
+  EXPECT_EQ(settled.message, "No callback received");
+}
+
+TEST(AuthFlow, ErrorWinsOverCallbackUrl) {
+  AuthUiResult result = AuthUiResult::Error("STATE_MISMATCH", "Bad state");
+  result.callbackUrl = "com.example.app://callback?code=abc";
+  FakeAuthUiBackend backend{std::move(result)};
+  Settled settled;
+  SignIn(backend, settled);
+
+  EXPECT_EQ(settled.resolves, 0);
+  EXPECT_EQ(settled.rejects, 1);
+}
+
+TEST(AuthFlow, CancelEndsAWaitingSignIn) {
+  FakeAuthUiBackend backend{AuthUiResult::Cancelled(), true};
+  Settled settled;
+  std::thread worker([&] { SignIn(backend, settled); });
+  backend.WaitUntilStarted();
+  backend.Cancel();
+  worker.join();
+
+  EXPECT_EQ(settled.resolves, 1);
+  EXPECT_EQ(settled.value, std::nullopt);
+}
+
+TEST(AuthFlow, FormatsOneLogLinePerAttempt) {
+  FakeAuthUiBackend backend{AuthUiResult::Cancelled()};
+  EXPECT_EQ(StarterApp::FormatAuthAttempt(backend, {"success", 8123}),
+            "[WebAuth] fake sign-in success after 8123ms\n");
+}
+
+} // namespace
@@ -0,0 +1,41 @@
+#include "Occlusion.h"
+
+#include <gtest/gtest.h>
+
+using StarterApp::IsFullyCovered;
+using StarterApp::ScreenRect;
+
+namespace {
+
+constexpr ScreenRect kWindow{100, 100, 500, 400};
+
+TEST(Occlusion, NothingAboveLeavesTheWindowVisible) {
+  EXPECT_FALSE(IsFullyCovered(kWindow, {}));
+}
+
+TEST(Occlusion, OneLargerWindowCovers) {
+  EXPECT_TRUE(IsFullyCovered(kWindow, {{0, 0, 1920, 1080}}));
+  EXPECT_TRUE(IsFullyCovered(kWindow, {kWindow}));
+}
+
+TEST(Occlusion, PartialOverlapDoesNotCover) {
+  EXPECT_FALSE(IsFullyCovered(kWindow, {{0, 0, 499, 1080}}));
+  EXPECT_FALSE(IsFullyCovered(kWindow, {{200, 200, 300, 300}}));
+}
+
+TEST(Occlusion, SeveralWindowsTogetherCover) {
+  // Left and right halves, overlapping in the middle.
+  EXPECT_TRUE(IsFullyCovered(kWindow, {{0, 0, 320, 1080}, {300, 50, 600, 450}}));
+  // Four tiles around a one-pixel hole.
+  EXPECT_FALSE(IsFullyCovered(kWindow, {{100, 100, 300, 250},
+                                        {301, 100, 500, 250},
+                                        {100, 250, 500, 400},
+                                        {100, 100, 500, 249}}));
+}
+
+TEST(Occlusion, EmptyRectsCoverNothing) {
+  EXPECT_FALSE(IsFullyCovered(kWindow, {{0, 0, 0, 0}, {600, 600, 500, 500}}));
+  EXPECT_TRUE(IsFullyCovered({10, 10, 10, 20}, {}));
+}
+
+} // namespace
@@ -0,0 +1,185 @@
+#include "ProfileWriter.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using StarterApp::ProfileData;
+
+namespace {
+
+std::string Symbolize(uint64_t address) {
+  return "app!fn" + std::to_string(address);
+}
+
+// A decoded protobuf field: varints in `value`, length-delimited in `bytes`.
+struct Field {
+  int number;
+  uint64_t value;
+  std::string bytes;
+};
+
+uint64_t ReadVarint(std::string_view &data) {
+  uint64_t value = 0;
+  for (int shift = 0; !data.empty(); shift += 7) {
+    auto byte = static_cast<uint8_t>(data.front());
+    data.remove_prefix(1);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      break;
+  }
+  return value;
+}
+
+std::vector<Field> Decode(std::string_view data) {
+  std::vector<Field> fields;
+  while (!data.empty()) {
+    uint64_t tag = ReadVarint(data);
+    Field field{static_cast<int>(tag >> 3), 0, {}};
+    if ((tag & 7) == 0) {
+      field.value = ReadVarint(data);
+    } else {
+      size_t size = ReadVarint(data);
+      field.bytes = std::string(data.substr(0, size));
+      data.remove_prefix(size);
+    }
+    fields.push_back(std::move(field));
+  }
+  return fields;
+}
+
+std::vector<uint64_t> DecodePacked(std::string_view data) {
+  std::vector<uint64_t> values;
+  while (!data.empty())
+    values.push_back(ReadVarint(data));
+  return values;
+}
+
+std::vector<Field> FieldsNumbered(const std::vector<Field> &fields, int number) {
+  std::vector<Field> matching;
+  for (const auto &field : fields) {
+    if (field.number == number)
+      matching.push_back(field);
+  }
+  return matching;
+}
+
+ProfileData TwoThreadProfile() {
+  ProfileData profile;
+  profile.intervalMs = 10;
+  profile.startedAtNs = 1000;
+  profile.durationNs = 5000000000;
+  uint64_t main = profile.AddThread("main");
+  uint64_t worker = profile.AddThread("worker;pool");
+  const uint64_t hot[] = {3, 2, 1}; // innermost first
+  const uint64_t cold[] = {4, 1};
+  profile.AddSample(main, hot, 3);
+  profile.AddSample(main, hot, 3);
+  profile.AddSample(main, cold, 2);
+  profile.AddSample(worker, cold, 2);
+  return profile;
+}
+
+} // namespace
+
+TEST(ProfileDataTest, AggregatesSamplesPerThreadAndStack) {
+  ProfileData profile = TwoThreadProfile();
+  ASSERT_EQ(profile.threads.size(), 2u);
+  const auto &main = profile.threads.begin()->second;
+  EXPECT_EQ(main.name, "main");
+  EXPECT_EQ(main.stacks.size(), 2u);
+  EXPECT_EQ(main.stacks.at({3, 2, 1}), 2u);
+  EXPECT_EQ(main.stacks.at({4, 1}), 1u);
+}
+
+TEST(ProfileDataTest, GivesEveryThreadItsOwnKey) {
+  ProfileData profile;
+  // The same name (or a reused OS id) must not merge two threads.
+  uint64_t first = profile.AddThread("thread-42");
+  uint64_t second = profile.AddThread("thread-42");
+  EXPECT_NE(first, second);
+  const uint64_t frames[] = {1};
+  profile.AddSample(second, frames, 1);
+  EXPECT_TRUE(profile.threads.at(first).stacks.empty());
+  EXPECT_EQ(profile.threads.at(second).stacks.size(), 1u);
+}
+
+TEST(ProfileDataTest, IgnoresEmptyStacks) {
+  ProfileData profile;
+  uint64_t thread = profile.AddThread("main");
+  profile.AddSample(thread, nullptr, 0);
+  EXPECT_TRUE(profile.threads.at(thread).stacks.empty());
+}
+
+TEST(WriteFoldedTest, WritesOutermostFirstWithCounts) {
+  std::ostringstream out;
+  StarterApp::WriteFolded(out, TwoThreadProfile(), Symbolize);
+  EXPECT_EQ(out.str(),
+            "main;app!fn1;app!fn2;app!fn3 2\n"
+            "main;app!fn1;app!fn4 1\n"
+            "worker:pool;app!fn1;app!fn4 1\n");
+}
+
+TEST(WritePprofTest, WritesAWellFormedProfile) {
+  std::ostringstream out;
+  StarterApp::WritePprof(out, TwoThreadProfile(), Symbolize);
+  auto profile = Decode(out.str());
+
+  std::vector<std::string> strings;
+  for (const auto &field : FieldsNumbered(profile, 6))
+    strings.push_back(field.bytes);
+  ASSERT_FALSE(strings.empty());
+  EXPECT_EQ(strings[0], "");
+  auto string = [&](uint64_t id) { return strings.at(id); };
+
+  // sample_type: samples/count, cpu/nanoseconds
+  auto sampleTypes = FieldsNumbered(profile, 1);
+  ASSERT_EQ(sampleTypes.size(), 2u);
+  auto cpu = Decode(sampleTypes[1].bytes);
+  EXPECT_EQ(string(cpu[0].value), "cpu");
+  EXPECT_EQ(string(cpu[1].value), "nanoseconds");
+
+  // Four distinct addresses, each with a function named by the symbolizer.
+  auto locations = FieldsNumbered(profile, 4);
+  auto functions = FieldsNumbered(profile, 5);
+  EXPECT_EQ(locations.size(), 4u);
+  EXPECT_EQ(functions.size(), 4u);
+  std::vector<uint64_t> addressById(locations.size() + 1);
+  for (const auto &location : locations) {
+    auto fields = Decode(location.bytes);
+    addressById.at(fields[0].value) = fields[1].value;
+  }
+
+  // Samples: leaf first, values {count, count * period}, thread label.
+  auto samples = FieldsNumbered(profile, 2);
+  ASSERT_EQ(samples.size(), 3u);
+  auto first = Decode(samples[0].bytes);
+  std::vector<uint64_t> addresses;
+  for (uint64_t id : DecodePacked(first[0].bytes))
+    addresses.push_back(addressById.at(id));
+  EXPECT_EQ(addresses, (std::vector<uint64_t>{3, 2, 1}));
+  EXPECT_EQ(DecodePacked(first[1].bytes),
+            (std::vector<uint64_t>{2, 2 * 10000000}));
+  auto label = Decode(first[2].bytes);
+  EXPECT_EQ(string(label[0].value), "thread");
+  EXPECT_EQ(string(label[1].value), "main");
+  auto last = Decode(samples[2].bytes);
+  EXPECT_EQ(string(Decode(last[2].bytes)[1].value), "worker;pool");
+
+  EXPECT_EQ(FieldsNumbered(profile, 9).at(0).value, 1000u);
+  EXPECT_EQ(FieldsNumbered(profile, 10).at(0).value, 5000000000u);
+  EXPECT_EQ(FieldsNumbered(profile, 12).at(0).value, 10000000u);
+}
+
+TEST(WritePprofTest, SymbolizesEachAddressOnce) {
+  int calls = 0;
+  std::ostringstream out;
+  StarterApp::WritePprof(out, TwoThreadProfile(), [&](uint64_t address) {
+    calls++;
+    return Symbolize(address);
+  });
+  EXPECT_EQ(calls, 4);
+}
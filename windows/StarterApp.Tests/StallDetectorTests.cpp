@@ -0,0 +1,127 @@
+#include "StallDetector.h"
+
+#include <gtest/gtest.h>
+
+using StarterApp::StallDetector;
+
+namespace {
+
+constexpr uint32_t kThresholdMs = 500;
+constexpr uint32_t kHeartbeatMs = 5000;
+constexpr size_t kMaxSamples = 3;
+
+// One watched thread; tick() runs a full Begin/Update/End cycle.
+struct Harness {
+  StallDetector detector{1, kThresholdMs, kHeartbeatMs, kMaxSamples, 0};
+  uint64_t now{0};
+  bool pending{false};
+  uint64_t beatAt{0};
+  uint32_t waitMs{0};
+
+  StallDetector::Step tick() {
+    detector.Begin(now);
+    auto step = detector.Update(0, pending, beatAt);
+    if (step.postHeartbeat)
+      pending = true;
+    waitMs = detector.End();
+    return step;
+  }
+
+  // Sleeps as the watcher would, then ticks.
+  StallDetector::Step wake() {
+    now += waitMs;
+    return tick();
+  }
+
+  void beat(uint64_t at) {
+    pending = false;
+    beatAt = at;
+  }
+};
+
+} // namespace
+
+TEST(StallDetectorTest, PostsHeartbeatsOnTheInterval) {
+  Harness h;
+  EXPECT_TRUE(h.tick().postHeartbeat);
+  EXPECT_EQ(h.waitMs, kThresholdMs); // check back for the answer
+
+  h.beat(10);
+  auto step = h.wake();
+  EXPECT_FALSE(step.postHeartbeat);
+  EXPECT_FALSE(step.recoveredAfterMs);
+  EXPECT_EQ(h.waitMs, kHeartbeatMs - kThresholdMs); // idle until the next one
+
+  EXPECT_TRUE(h.wake().postHeartbeat);
+  EXPECT_EQ(h.now, kHeartbeatMs);
+}
+
+TEST(StallDetectorTest, SamplesAStalledThreadAThresholdApartUpToTheLimit) {
+  Harness h;
+  h.tick();
+
+  auto step = h.wake();
+  EXPECT_TRUE(step.sampleStack);
+  EXPECT_EQ(step.stalledMs, kThresholdMs);
+
+  int samples = 1;
+  for (int i = 0; i < 10; i++)
+    samples += h.wake().sampleStack ? 1 : 0;
+  EXPECT_EQ(samples, static_cast<int>(kMaxSamples));
+  EXPECT_EQ(h.waitMs, kThresholdMs); // keeps watching until it recovers
+}
+
+TEST(StallDetectorTest, ReportsRecoveryOnceWithTheHeartbeatDelay) {
+  Harness h;
+  h.tick();
+  h.wake();
+  h.wake();
+  h.beat(1200);
+
+  auto step = h.wake();
+  ASSERT_TRUE(step.recoveredAfterMs);
+  EXPECT_EQ(*step.recoveredAfterMs, 1200u);
+  EXPECT_FALSE(h.wake().recoveredAfterMs);
+}
+
+TEST(StallDetectorTest, IgnoresDelaysUnderTheThreshold) {
+  Harness h;
+  h.tick();
+  h.now += kThresholdMs - 1;
+  h.detector.Begin(h.now);
+  EXPECT_FALSE(h.detector.Update(0, true, 0).sampleStack);
+}
+
+TEST(StallDetectorTest, DoesNotBlameThreadsForAPausedProcess) {
+  Harness h;
+  h.tick();
+  // The watcher itself woke up far too late (system sleep).
+  h.now += 60 * 1000;
+  EXPECT_FALSE(h.tick().sampleStack);
+  // The measurement restarts from the late wake-up.
+  EXPECT_TRUE(h.wake().sampleStack);
+}
+
+TEST(StallDetectorTest, TracksThreadsIndependently) {
+  StallDetector detector{2, kThresholdMs, kHeartbeatMs, kMaxSamples, 0};
+  detector.Begin(0);
+  EXPECT_TRUE(detector.Update(0, false, 0).postHeartbeat);
+  EXPECT_TRUE(detector.Update(1, false, 0).postHeartbeat);
+  detector.End();
+
+  detector.Begin(kThresholdMs);
+  EXPECT_FALSE(detector.Update(0, false, 20).sampleStack);
+  EXPECT_TRUE(detector.Update(1, true, 0).sampleStack);
+  EXPECT_EQ(detector.End(), kThresholdMs);
+}
+
+TEST(StallDetectorTest, HeartbeatIntervalIsAtLeastTheThreshold) {
+  StallDetector detector{1, 8000, kHeartbeatMs, kMaxSamples, 0};
+  detector.Begin(0);
+  detector.Update(0, false, 0);
+  detector.End();
+  detector.Begin(8000);
+  detector.Update(0, false, 10);
+  // Heartbeat due at 8000, not 5000.
+  EXPECT_EQ(detector.End(), 8000u);
+}
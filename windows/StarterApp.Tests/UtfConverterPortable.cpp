@@ -0,0 +1,107 @@
+// Stands in for UtfConverterWin32.cpp off Windows, with the same strictness
+// as MB_ERR_INVALID_CHARS / WC_ERR_INVALID_CHARS. Emits UTF-16 code units
+// even where wchar_t is 32 bits, as the app's callers expect.
+#include "UtfConverter.h"
+
+#include <cstdint>
+#include <string>
+
+namespace StarterApp::detail {
+
+namespace {
+
+// Decodes one scalar value at `in[i]`, advancing `i`; -1 if malformed.
+int32_t DecodeUtf8(std::string_view in, size_t &i) {
+  auto byte = [&](size_t at) { return static_cast<uint8_t>(in[at]); };
+  uint8_t lead = byte(i);
+  if (lead < 0x80) {
+    i++;
+    return lead;
+  }
+  size_t length;
+  int32_t value;
+  int32_t min;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 2, value = lead & 0x1F, min = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 3, value = lead & 0x0F, min = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 4, value = lead & 0x07, min = 0x10000;
+  } else {
+    return -1;
+  }
+  if (i + length > in.size())
+    return -1;
+  for (size_t k = 1; k < length; k++) {
+    if ((byte(i + k) & 0xC0) != 0x80)
+      return -1;
+    value = (value << 6) | (byte(i + k) & 0x3F);
+  }
+  if (value < min || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF))
+    return -1;
+  i += length;
+  return value;
+}
+
+} // namespace
+
+int ConvertUtf8ToUtf16(std::string_view in, wchar_t *out, size_t capacity) {
+  size_t written = 0;
+  auto put = [&](uint32_t unit) {
+    if (written == capacity)
+      return false;
+    out[written++] = static_cast<wchar_t>(unit);
+    return true;
+  };
+  for (size_t i = 0; i < in.size();) {
+    int32_t value = DecodeUtf8(in, i);
+    if (value < 0)
+      return -1;
+    bool ok = value < 0x10000
+                  ? put(value)
+                  : put(0xD800 + ((value - 0x10000) >> 10)) &&
+                        put(0xDC00 + ((value - 0x10000) & 0x3FF));
+    if (!ok)
+      return -1;
+  }
+  return static_cast<int>(written);
+}
+
+int ConvertUtf16ToUtf8(std::wstring_view in, char *out, size_t capacity) {
+  std::string bytes;
+  for (size_t i = 0; i < in.size(); i++) {
+    uint32_t value = static_cast<uint32_t>(in[i]);
+    if (value >= 0xDC00 && value <= 0xDFFF)
+      return -1;
+    if (value >= 0xD800 && value <= 0xDBFF) {
+      uint32_t low = i + 1 < in.size() ? static_cast<uint32_t>(in[i + 1]) : 0;
+      if (low < 0xDC00 || low > 0xDFFF)
+        return -1;
+      value = 0x10000 + ((value - 0xD800) << 10) + (low - 0xDC00);
+      i++;
+    }
+    if (value < 0x80) {
+      bytes += static_cast<char>(value);
+    } else if (value < 0x800) {
+      bytes += static_cast<char>(0xC0 | (value >> 6));
+      bytes += static_cast<char>(0x80 | (value & 0x3F));
+    } else if (value < 0x10000) {
+      bytes += static_cast<char>(0xE0 | (value >> 12));
+      bytes += static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+      bytes += static_cast<char>(0x80 | (value & 0x3F));
+    } else {
+      bytes += static_cast<char>(0xF0 | (value >> 18));
+      bytes += static_cast<char>(0x80 | ((value >> 12) & 0x3F));
+      bytes += static_cast<char>(0x80 | ((value >> 6) & 0x3F));
+      bytes += static_cast<char>(0x80 | (value & 0x3F));
+    }
+  }
+  if (out) {
+    if (bytes.size() > capacity)
+      return -1;
+    bytes.copy(out, bytes.size());
+  }
+  return static_cast<int>(bytes.size());
+}
+
+} // namespace StarterApp::detail
@@ -0,0 +1,67 @@
+#include "Utf.h"
+
+#include <gtest/gtest.h>
+
+using StarterApp::Utf16ToUtf8;
+using StarterApp::Utf8ToUtf16;
+
+namespace {
+
+// Long enough to go through the vector ASCII path before the rest.
+const std::string kPrefix = "https://example.com/callback?state=";
+const std::wstring kWidePrefix = L"https://example.com/callback?state=";
+
+TEST(Utf, RoundTripsValidUtf8) {
+  // Empty, ASCII only, and ASCII followed by 2-, 3- and 4-byte sequences
+  // ("é", "日本", U+1F600).
+  const std::string valid[] = {
+      "",
+      "abc",
+      kPrefix,
+      kPrefix + "\xC3\xA9\xE6\x97\xA5\xE6\x9C\xAC\xF0\x9F\x98\x80",
+      "\xC3\xA9" + kPrefix,
+  };
+  for (const auto &utf8 : valid) {
+    auto utf16 = Utf8ToUtf16(utf8);
+    ASSERT_TRUE(utf16) << utf8;
+    EXPECT_EQ(Utf16ToUtf8(*utf16), utf8);
+  }
+}
+
+TEST(Utf, WidensAsciiAndTheRest) {
+  EXPECT_EQ(Utf8ToUtf16(kPrefix), kWidePrefix);
+  EXPECT_EQ(Utf8ToUtf16(kPrefix + "\xC3\xA9"), kWidePrefix + L"\u00E9");
+
+  // Supplementary characters become a surrogate pair.
+  std::wstring emoji = kWidePrefix;
+  emoji += static_cast<wchar_t>(0xD83D);
+  emoji += static_cast<wchar_t>(0xDE00);
+  EXPECT_EQ(Utf8ToUtf16(kPrefix + "\xF0\x9F\x98\x80"), emoji);
+  EXPECT_EQ(Utf16ToUtf8(emoji), kPrefix + "\xF0\x9F\x98\x80");
+}
+
+TEST(Utf, RejectsMalformedUtf8) {
+  // Overlong, surrogate, truncated and above U+10FFFF, also after the prefix
+  // so the check runs past the vector path.
+  const std::string invalid[] = {
+      "\xC0\xAF", "\xED\xA0\x80", "\xE6\x97", "\xF4\x90\x80\x80",
+  };
+  for (const auto &bad : invalid) {
+    EXPECT_FALSE(Utf8ToUtf16(bad));
+    EXPECT_FALSE(Utf8ToUtf16(kPrefix + bad));
+  }
+}
+
+TEST(Utf, RejectsUnpairedSurrogates) {
+  const std::wstring invalid[] = {
+      std::wstring(1, static_cast<wchar_t>(0xD800)),
+      std::wstring(1, static_cast<wchar_t>(0xDC00)),
+      std::wstring(1, static_cast<wchar_t>(0xD800)) + L"a",
+  };
+  for (const auto &bad : invalid) {
+    EXPECT_FALSE(Utf16ToUtf8(bad));
+    EXPECT_FALSE(Utf16ToUtf8(kWidePrefix + bad));
+  }
+}
+
+} // namespace
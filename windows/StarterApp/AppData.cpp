@@ -0,0 +1,21 @@
+#include "pch.h"
+#include "AppData.h"
+
+#include <shlobj.h>
+
+namespace StarterApp {
+
+std::optional<std::wstring> AppDataFilePath(std::wstring_view fileName) {
+  PWSTR localAppData = nullptr;
+  if (FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr,
+                                  &localAppData)))
+    return std::nullopt;
+  std::wstring directory = std::wstring(localAppData) + L"\\StarterApp";
+  CoTaskMemFree(localAppData);
+  if (!CreateDirectoryW(directory.c_str(), nullptr) &&
+      GetLastError() != ERROR_ALREADY_EXISTS)
+    return std::nullopt;
+  return directory + L"\\" + std::wstring(fileName);
+}
+
+} // namespace StarterApp
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "pch.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace StarterApp {
+
+// Path of `fileName` in %LOCALAPPDATA%\StarterApp, creating the directory.
+// Returns nullopt if the directory can't be located or created.
+std::optional<std::wstring> AppDataFilePath(std::wstring_view fileName);
+
+} // namespace StarterApp
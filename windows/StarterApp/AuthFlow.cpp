@@ -0,0 +1,39 @@
+#include "AuthFlow.h"
+
+#include <chrono>
+
+namespace StarterApp {
+
+AuthAttempt RunAuthentication(
+    IAuthUiBackend &backend, const std::string &url,
+    const std::string &callbackScheme,
+    const std::function<void(std::optional<std::string>)> &resolve,
+    const std::function<void(std::string, std::string)> &reject) {
+  auto start = std::chrono::steady_clock::now();
+  AuthUiResult result = backend.Authenticate(url, callbackScheme);
+  uint64_t elapsedMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count();
+
+  // An error wins over a callback URL, so a backend can't half-succeed.
+  if (!result.errorCode.empty()) {
+    reject(std::move(result.errorCode), std::move(result.errorMessage));
+    return {"error", elapsedMs};
+  }
+  if (result.callbackUrl) {
+    resolve(std::move(result.callbackUrl));
+    return {"success", elapsedMs};
+  }
+  resolve(std::nullopt);
+  return {"cancelled", elapsedMs};
+}
+
+std::string FormatAuthAttempt(const IAuthUiBackend &backend,
+                              const AuthAttempt &attempt) {
+  return std::string("[WebAuth] ") + backend.Name() + " sign-in " +
+         attempt.outcome + " after " + std::to_string(attempt.elapsedMs) +
+         "ms\n";
+}
+
+} // namespace StarterApp
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AuthUiBackend.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace StarterApp {
+
+// How one sign-in ended, for the diagnostic log.
+struct AuthAttempt {
+  // "success", "cancelled" or "error".
+  const char *outcome;
+  uint64_t elapsedMs;
+};
+
+// Runs one sign-in on `backend` and settles it the way
+// WebAuthModule::authenticate settles its promise: `resolve` with the
+// callback URL, `resolve` with nullopt when the user cancelled or the flow
+// timed out, `reject` with the backend's code and message when it failed.
+// Blocks for as long as the backend does.
+AuthAttempt RunAuthentication(
+    IAuthUiBackend &backend, const std::string &url,
+    const std::string &callbackScheme,
+    const std::function<void(std::optional<std::string>)> &resolve,
+    const std::function<void(std::string, std::string)> &reject);
+
+// One log line comparing backends, e.g.
+// "[WebAuth] loopback sign-in success after 8123ms\n".
+std::string FormatAuthAttempt(const IAuthUiBackend &backend,
+                              const AuthAttempt &attempt);
+
+} // namespace StarterApp
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace StarterApp {
+
+// Outcome of presenting an authorization URL to the user.
+struct AuthUiResult {
+  // `<callbackScheme>://callback?<query>` on success; empty if the user
+  // cancelled or the flow timed out.
+  std::optional<std::string> callbackUrl;
+  // Set (with errorMessage) when the flow failed rather than being cancelled.
+  std::string errorCode;
+  std::string errorMessage;
+
+  static AuthUiResult Cancelled() { return {}; }
+  static AuthUiResult Error(std::string code, std::string message) {
+    return {std::nullopt, std::move(code), std::move(message)};
+  }
+};
+
+// Presents an OAuth authorization URL and captures the redirect.
+// WebAuthModule::authenticate calls Authenticate on a worker thread, so
+// implementations may block.
+class IAuthUiBackend {
+ public:
+  virtual ~IAuthUiBackend() = default;
+
+  // Short label for logs ("loopback", "protocol").
+  virtual const char *Name() const noexcept = 0;
+
+  virtual AuthUiResult Authenticate(const std::string &url,
+                                    const std::string &callbackScheme) = 0;
+
+  // Ends a pending Authenticate early with Cancelled, e.g. when the user
+  // dismisses the sign-in screen. Backends whose wait can't be interrupted
+  // ignore it and run to their timeout.
+  virtual void Cancel() noexcept {}
+};
+
+// System browser + loopback HTTP listener (RFC 8252 section 7.3).
+std::shared_ptr<IAuthUiBackend> CreateLoopbackAuthUiBackend();
+
+// System browser + private-use URI scheme redirect (RFC 8252 section 7.1).
+// Registers `<callbackScheme>:` for this executable under HKCU; the redirect
+// relaunches the app, and the single-instance forwarder hands the URL to the
+// running instance via DeliverAuthActivation. Only one sign-in waits at a
+// time: starting another cancels the first, as does Cancel.
+std::shared_ptr<IAuthUiBackend> CreateProtocolAuthUiBackend();
+
+// False when running from an MSIX package. A packaged full-trust app's HKCU
+// writes go to a private per-package hive the shell never reads, so the
+// scheme registration would not take effect; use the loopback backend.
+bool CanUseProtocolAuthUi() noexcept;
+
+// Completes a pending protocol-backend sign-in with an activation URL.
+// Returns false if no sign-in is waiting for this URL's scheme.
+bool DeliverAuthActivation(const std::string &url) noexcept;
+
+} // namespace StarterApp
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "BackupModule.h"
+
+#include "AppData.h"
+#include "ThreadQos.h"
+
+#include <optional>
+#include <thread>
+
+namespace StarterApp {
+
+namespace {
+
+// The backup holds a few small preference entries.
+constexpr DWORD kMaxBackupBytes = 1024 * 1024;
+
+std::optional<std::wstring> BackupPath() {
+  return AppDataFilePath(L"preferences-backup.json");
+}
+
+} // namespace
+
+void BackupModule::readBackup(
+    React::ReactPromise<React::JSValue> result) noexcept {
+  std::thread([result]() mutable {
+    ScopedWorkClass workClass{WorkClass::Utility};
+    auto path = BackupPath();
+    if (!path) {
+      result.Reject(React::ReactError{"BACKUP_PATH_ERROR",
+                                      "Failed to locate the backup directory"});
+      return;
+    }
+    HANDLE file = CreateFileW(path->c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      if (GetLastError() == ERROR_FILE_NOT_FOUND) {
+        result.Resolve(React::JSValue{nullptr});
+      } else {
+        result.Reject(React::ReactError{"BACKUP_READ_ERROR",
+                                        "Failed to open the backup file"});
+      }
+      return;
+    }
+    LARGE_INTEGER size{};
+    std::string contents;
+    bool ok = GetFileSizeEx(file, &size) && size.QuadPart <= kMaxBackupBytes;
+    if (ok) {
+      contents.resize(static_cast<size_t>(size.QuadPart));
+      DWORD read = 0;
+      ok = ReadFile(file, contents.data(), static_cast<DWORD>(contents.size()),
+                    &read, nullptr) &&
+           read == contents.size();
+    }
+    CloseHandle(file);
+    if (!ok) {
+      result.Reject(React::ReactError{"BACKUP_READ_ERROR",
+                                      "Failed to read the backup file"});
+      return;
+    }
+    result.Resolve(React::JSValue{std::move(contents)});
+  }).detach();
+}
+
+void BackupModule::writeBackup(std::string contents,
+                               React::ReactPromise<bool> result) noexcept {
+  std::thread([contents = std::move(contents), result]() mutable {
+    ScopedWorkClass workClass{WorkClass::Background};
+    auto path = BackupPath();
+    if (!path || contents.size() > kMaxBackupBytes) {
+      result.Reject(React::ReactError{"BACKUP_WRITE_ERROR",
+                                      "Failed to write the backup file"});
+      return;
+    }
+    std::wstring tempPath = *path + L".tmp";
+    HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    bool ok = file != INVALID_HANDLE_VALUE;
+    if (ok) {
+      DWORD written = 0;
+      ok = WriteFile(file, contents.data(), static_cast<DWORD>(contents.size()),
+                     &written, nullptr) &&
+           written == contents.size() && FlushFileBuffers(file);
+      CloseHandle(file);
+    }
+    ok = ok && MoveFileExW(tempPath.c_str(), path->c_str(),
+                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!ok) {
+      DeleteFileW(tempPath.c_str());
+      result.Reject(React::ReactError{"BACKUP_WRITE_ERROR",
+                                      "Failed to write the backup file"});
+      return;
+    }
+    result.Resolve(true);
+  }).detach();
+}
+
+} // namespace StarterApp
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "pch.h"
+#include "NativeModules.h"
+#include <winrt/Microsoft.ReactNative.h>
+
+#include <string>
+
+namespace StarterApp {
+
+// Keeps the preference backup in its own file under
+// %LOCALAPPDATA%\StarterApp, outside the AsyncStorage database it protects.
+REACT_MODULE(BackupModule)
+struct BackupModule {
+  // Resolves with the backup file's contents, or null if there is none.
+  REACT_METHOD(readBackup)
+  void readBackup(React::ReactPromise<React::JSValue> result) noexcept;
+
+  // Replaces the backup file with `contents`. The new file is written
+  // beside the old one and moved over it, so a crash mid-write leaves the
+  // previous backup intact.
+  REACT_METHOD(writeBackup)
+  void writeBackup(std::string contents,
+                   React::ReactPromise<bool> result) noexcept;
+};
+
+} // namespace StarterApp
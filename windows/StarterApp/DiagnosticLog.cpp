@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "DiagnosticLog.h"
+
+#include "AppData.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace StarterApp {
+
+namespace {
+
+constexpr LONGLONG kMaxLogBytes = 1024 * 1024;
+
+std::mutex g_logMutex;
+
+HANDLE OpenLog(const std::wstring &path) {
+  return CreateFileW(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, nullptr,
+                     OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+}
+
+// `2026-01-31T12:34:56.789Z ` in UTC.
+std::string Timestamp() {
+  SYSTEMTIME now;
+  GetSystemTime(&now);
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%04u-%02u-%02uT%02u:%02u:%02u.%03uZ ",
+           now.wYear, now.wMonth, now.wDay, now.wHour, now.wMinute,
+           now.wSecond, now.wMilliseconds);
+  return buffer;
+}
+
+} // namespace
+
+void AppendDiagnosticLog(std::string_view text) noexcept {
+  try {
+    std::string entry = Timestamp();
+    entry.append(text);
+    if (entry.back() != '\n')
+      entry.push_back('\n');
+
+    std::lock_guard<std::mutex> lock(g_logMutex);
+    static const auto path = AppDataFilePath(L"diagnostics.log");
+    if (!path)
+      return;
+    HANDLE file = OpenLog(*path);
+    if (file == INVALID_HANDLE_VALUE)
+      return;
+    LARGE_INTEGER size{};
+    if (GetFileSizeEx(file, &size) && size.QuadPart > kMaxLogBytes) {
+      CloseHandle(file);
+      MoveFileExW(path->c_str(), (*path + L".old").c_str(),
+                  MOVEFILE_REPLACE_EXISTING);
+      file = OpenLog(*path);
+      if (file == INVALID_HANDLE_VALUE)
+        return;
+    }
+    DWORD written = 0;
+    WriteFile(file, entry.data(), static_cast<DWORD>(entry.size()), &written,
+              nullptr);
+    CloseHandle(file);
+  } catch (...) {
+    // Diagnostics must never take the app down.
+  }
+}
+
+} // namespace StarterApp
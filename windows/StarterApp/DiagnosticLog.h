@@ -0,0 +1,16 @@
+#pragma once
+
+#include "pch.h"
+
+#include <string_view>
+
+namespace StarterApp {
+
+// Appends a timestamped entry to %LOCALAPPDATA%\StarterApp\diagnostics.log,
+// for reports that must outlive the session without a debugger attached
+// (stalls, metrics dumps). Once the file passes 1 MB it is kept as
+// diagnostics.log.old and a new one is started. Thread-safe; does blocking
+// file I/O, so call it off the JS and UI threads.
+void AppendDiagnosticLog(std::string_view text) noexcept;
+
+} // namespace StarterApp
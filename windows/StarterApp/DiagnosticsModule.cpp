@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "DiagnosticsModule.h"
+
+#include "DiagnosticLog.h"
+#include "Profiler.h"
+#include "ThreadQos.h"
+#include "Utf.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace StarterApp {
+
+void DiagnosticsModule::Initialize(
+    winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept {
+  m_reactContext = reactContext;
+}
+
+void DiagnosticsModule::getThreadCpuTimes(
+    React::ReactPromise<React::JSValue> result) noexcept {
+  React::JSValueObject times;
+  times["interactive"] = static_cast<int64_t>(
+      WorkClassCpuTimeMs(WorkClass::Interactive));
+  times["utility"] =
+      static_cast<int64_t>(WorkClassCpuTimeMs(WorkClass::Utility));
+  times["background"] =
+      static_cast<int64_t>(WorkClassCpuTimeMs(WorkClass::Background));
+  result.Resolve(React::JSValue{std::move(times)});
+}
+
+void DiagnosticsModule::getProcessCpuTime(
+    React::ReactPromise<double> result) noexcept {
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+    result.Reject(
+        React::ReactError{"CPU_TIME_ERROR", "GetProcessTimes failed"});
+    return;
+  }
+  auto toUInt64 = [](const FILETIME &ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+  };
+  // FILETIME ticks are 100ns.
+  result.Resolve(static_cast<double>(toUInt64(kernel) + toUInt64(user)) /
+                 10000.0);
+}
+
+void DiagnosticsModule::startProfiler(
+    int intervalMs, React::ReactPromise<bool> result) noexcept {
+  result.Resolve(StartProfiler(static_cast<uint32_t>(std::max(intervalMs, 0))));
+}
+
+void DiagnosticsModule::stopProfiler(
+    std::string format, React::ReactPromise<std::string> result) noexcept {
+  if (!IsProfilerRunning()) {
+    result.Reject(
+        React::ReactError{"PROFILER_NOT_RUNNING", "The profiler is not running"});
+    return;
+  }
+  // Joining the sampler and symbolizing can take a while; keep it off the JS
+  // thread.
+  ProfileFormat profileFormat =
+      format == "folded" ? ProfileFormat::Folded : ProfileFormat::Pprof;
+  std::thread([result, profileFormat]() mutable {
+    ScopedWorkClass workClass{WorkClass::Utility};
+    auto path = Utf16ToUtf8(StopProfiler(profileFormat));
+    if (!path || path->empty()) {
+      result.Reject(
+          React::ReactError{"PROFILER_WRITE_ERROR", "Failed to write the profile"});
+      return;
+    }
+    result.Resolve(*path);
+  }).detach();
+}
+
+void DiagnosticsModule::appendLog(std::string text) noexcept {
+  std::thread([text = std::move(text)] {
+    ScopedWorkClass workClass{WorkClass::Background};
+    AppendDiagnosticLog(text);
+  }).detach();
+}
+
+} // namespace StarterApp
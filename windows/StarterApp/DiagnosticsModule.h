@@ -0,0 +1,41 @@
+#pragma once
+
+#include "pch.h"
+#include "NativeModules.h"
+#include <winrt/Microsoft.ReactNative.h>
+
+namespace StarterApp {
+
+REACT_MODULE(DiagnosticsModule)
+struct DiagnosticsModule {
+  REACT_INIT(Initialize)
+  void Initialize(winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept;
+
+  REACT_METHOD(getThreadCpuTimes)
+  void getThreadCpuTimes(React::ReactPromise<React::JSValue> result) noexcept;
+
+  // Resolves with the process's total CPU time (user + kernel) in milliseconds.
+  REACT_METHOD(getProcessCpuTime)
+  void getProcessCpuTime(React::ReactPromise<double> result) noexcept;
+
+  // Starts the sampling profiler (0 picks the default interval). Resolves
+  // false if it is already running.
+  REACT_METHOD(startProfiler)
+  void startProfiler(int intervalMs, React::ReactPromise<bool> result) noexcept;
+
+  // Stops the profiler and resolves with the path of the profile, written as
+  // pprof or, for `format == "folded"`, folded stacks.
+  REACT_METHOD(stopProfiler)
+  void stopProfiler(std::string format,
+                    React::ReactPromise<std::string> result) noexcept;
+
+  // Appends `text` to the diagnostic log (see DiagnosticLog.h) off the JS
+  // thread.
+  REACT_METHOD(appendLog)
+  void appendLog(std::string text) noexcept;
+
+ private:
+  winrt::Microsoft::ReactNative::ReactContext m_reactContext;
+};
+
+} // namespace StarterApp
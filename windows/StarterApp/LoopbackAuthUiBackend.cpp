@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "AuthUiBackend.h"
+
+#include "Utf.h"
+
+#include <shellapi.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include <regex>
+#include <string>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace StarterApp {
+
+namespace {
+
+// Opens the authorization URL in the user's default browser with a
+// `http://127.0.0.1:<port>/callback` redirect and waits (up to 60 seconds)
+// for the browser to hit the loopback listener.
+class LoopbackAuthUiBackend final : public IAuthUiBackend {
+ public:
+  const char *Name() const noexcept override { return "loopback"; }
+  AuthUiResult Authenticate(const std::string &url,
+                            const std::string &callbackScheme) override;
+};
+
+AuthUiResult LoopbackAuthUiBackend::Authenticate(
+    const std::string &url, const std::string &callbackScheme) {
+  WSADATA wsaData;
+  if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+    return AuthUiResult::Error("SOCKET_ERROR", "Failed to initialize Winsock");
+  }
+
+  SOCKET listenSock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (listenSock == INVALID_SOCKET) {
+    WSACleanup();
+    return AuthUiResult::Error("SOCKET_ERROR", "Failed to create socket");
+  }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+
+  if (bind(listenSock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
+      SOCKET_ERROR) {
+    closesocket(listenSock);
+    WSACleanup();
+    return AuthUiResult::Error("SOCKET_ERROR", "Failed to bind socket");
+  }
+
+  int addrLen = sizeof(addr);
+  getsockname(listenSock, reinterpret_cast<sockaddr *>(&addr), &addrLen);
+  int port = ntohs(addr.sin_port);
+
+  if (listen(listenSock, 1) == SOCKET_ERROR) {
+    closesocket(listenSock);
+    WSACleanup();
+    return AuthUiResult::Error("SOCKET_ERROR", "Failed to listen on socket");
+  }
+
+  std::string redirectUri =
+      "http://127.0.0.1:" + std::to_string(port) + "/callback";
+
+  std::string fullUrl = url;
+  if (fullUrl.find('?') != std::string::npos)
+    fullUrl += "&redirect_uri=" + redirectUri;
+  else
+    fullUrl += "?redirect_uri=" + redirectUri;
+
+  auto wUrl = Utf8ToUtf16(fullUrl);
+  if (!wUrl) {
+    closesocket(listenSock);
+    WSACleanup();
+    return AuthUiResult::Error("INVALID_URL",
+                               "Authorization URL is not valid UTF-8");
+  }
+  ShellExecuteW(nullptr, L"open", wUrl->c_str(), nullptr, nullptr,
+                SW_SHOWNORMAL);
+
+  DWORD timeout = 60000;
+  setsockopt(listenSock, SOL_SOCKET, SO_RCVTIMEO,
+             reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+
+  SOCKET clientSock = accept(listenSock, nullptr, nullptr);
+  if (clientSock == INVALID_SOCKET) {
+    closesocket(listenSock);
+    WSACleanup();
+    return AuthUiResult::Cancelled();
+  }
+
+  char buf[4096];
+  int bytesRead = recv(clientSock, buf, sizeof(buf) - 1, 0);
+  if (bytesRead <= 0) {
+    closesocket(clientSock);
+    closesocket(listenSock);
+    WSACleanup();
+    return AuthUiResult::Cancelled();
+  }
+  buf[bytesRead] = '\0';
+
+  const char *response =
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/html\r\n"
+      "Connection: close\r\n\r\n"
+      "<html><body><p>Authentication complete. You may close this "
+      "tab.</p><script>window.close()</script></body></html>";
+  send(clientSock, response, static_cast<int>(strlen(response)), 0);
+  closesocket(clientSock);
+  closesocket(listenSock);
+  WSACleanup();
+
+  std::string request(buf);
+  std::regex requestLineRegex(R"(GET\s+(/\S+)\s+HTTP)");
+  std::smatch match;
+  if (std::regex_search(request, match, requestLineRegex)) {
+    std::string path = match[1].str();
+    auto qPos = path.find('?');
+    if (qPos == std::string::npos) {
+      return AuthUiResult::Cancelled();
+    }
+    std::string callbackUrl =
+        callbackScheme + "://callback" + path.substr(qPos);
+    return AuthUiResult{callbackUrl};
+  }
+  return AuthUiResult::Cancelled();
+}
+
+} // namespace
+
+std::shared_ptr<IAuthUiBackend> CreateLoopbackAuthUiBackend() {
+  return std::make_shared<LoopbackAuthUiBackend>();
+}
+
+} // namespace StarterApp
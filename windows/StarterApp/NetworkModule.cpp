@@ -0,0 +1,196 @@
+#include "pch.h"
+#include "NetworkModule.h"
+
+#include "ThreadQos.h"
+#include "Utf.h"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <unordered_set>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace StarterApp {
+
+using winrt::Windows::Networking::Connectivity::NetworkConnectivityLevel;
+using winrt::Windows::Networking::Connectivity::NetworkInformation;
+
+struct PrefetchRequest;
+
+// Lookups started by prefetchHosts and not yet completed. Kept alive by each
+// request, so a completion that outlasts the module still has somewhere to
+// report to.
+struct PrefetchState {
+  std::mutex mutex;
+  std::condition_variable drained;
+  std::unordered_set<PrefetchRequest *> pending;
+};
+
+namespace {
+
+// Long enough for cancelled lookups to complete; a shutdown should not hang
+// on a stuck resolver.
+constexpr auto kPrefetchDrainTimeout = std::chrono::seconds(2);
+
+} // namespace
+
+// State for one in-flight GetAddrInfoExW call; freed by its completion routine.
+struct PrefetchRequest {
+  OVERLAPPED overlapped{};
+  PADDRINFOEXW result{nullptr};
+  HANDLE cancel{nullptr};
+  std::wstring host;
+  std::shared_ptr<PrefetchState> state;
+};
+
+namespace {
+
+void CALLBACK OnPrefetchComplete(DWORD /* error */, DWORD /* bytes */,
+                                 LPWSAOVERLAPPED overlapped) {
+  auto *request = CONTAINING_RECORD(overlapped, PrefetchRequest, overlapped);
+  if (request->result)
+    FreeAddrInfoExW(request->result);
+  auto state = std::move(request->state);
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->pending.erase(request);
+    delete request;
+  }
+  state->drained.notify_all();
+}
+
+} // namespace
+
+void NetworkModule::Initialize(
+    winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept {
+  m_reactContext = reactContext;
+  WSADATA wsaData;
+  m_winsockReady = WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+  m_prefetches = std::make_shared<PrefetchState>();
+
+  m_reachability = std::make_shared<ReachabilityState>();
+  m_reachability->onChanged = [this](bool online) {
+    if (onReachabilityChanged)
+      onReachabilityChanged(online);
+  };
+
+  // NetworkStatusChanged fires on a background thread, often several times
+  // per transition; only actual changes are forwarded to JS.
+  std::weak_ptr<ReachabilityState> weakState = m_reachability;
+  m_statusChangedToken = NetworkInformation::NetworkStatusChanged(
+      [weakState](winrt::Windows::Foundation::IInspectable const &) {
+        UpdateReachability(weakState);
+      });
+
+  // Querying the connection profile can block; keep it off the JS thread.
+  std::thread([weakState] {
+    ScopedWorkClass workClass{WorkClass::Utility};
+    UpdateReachability(weakState);
+  }).detach();
+}
+
+NetworkModule::~NetworkModule() noexcept {
+  if (m_statusChangedToken)
+    NetworkInformation::NetworkStatusChanged(m_statusChangedToken);
+  if (m_reachability) {
+    // Waits out a handler that is already running.
+    std::lock_guard<std::mutex> lock(m_reachability->mutex);
+    m_reachability->onChanged = nullptr;
+  }
+  if (m_winsockReady && m_prefetches) {
+    // Pending lookups still use Winsock: cancel them and wait for their
+    // completion routines before cleaning it up. If one doesn't finish in
+    // time, leave Winsock initialized rather than pull it from under it.
+    // Cancelling happens outside the lock in case a completion routine runs
+    // on this thread; a handle whose lookup completed meanwhile just fails.
+    std::vector<HANDLE> cancels;
+    {
+      std::lock_guard<std::mutex> lock(m_prefetches->mutex);
+      for (auto *request : m_prefetches->pending)
+        cancels.push_back(request->cancel);
+    }
+    for (HANDLE &cancel : cancels)
+      GetAddrInfoExCancel(&cancel);
+    std::unique_lock<std::mutex> lock(m_prefetches->mutex);
+    bool drained = m_prefetches->drained.wait_for(
+        lock, kPrefetchDrainTimeout,
+        [state = m_prefetches.get()] { return state->pending.empty(); });
+    lock.unlock();
+    if (drained)
+      WSACleanup();
+  } else if (m_winsockReady) {
+    WSACleanup();
+  }
+}
+
+void NetworkModule::UpdateReachability(
+    std::weak_ptr<ReachabilityState> weakState) noexcept {
+  auto state = weakState.lock();
+  if (!state)
+    return;
+  bool online = IsInternetAvailable();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (state->online.exchange(online) != online && state->onChanged)
+    state->onChanged(online);
+}
+
+bool NetworkModule::IsInternetAvailable() noexcept {
+  try {
+    auto profile = NetworkInformation::GetInternetConnectionProfile();
+    if (!profile)
+      return false;
+    auto level = profile.GetNetworkConnectivityLevel();
+    return level == NetworkConnectivityLevel::InternetAccess ||
+           level == NetworkConnectivityLevel::ConstrainedInternetAccess;
+  } catch (...) {
+    // If connectivity cannot be determined, let requests try.
+    return true;
+  }
+}
+
+void NetworkModule::getReachability(React::ReactPromise<bool> result) noexcept {
+  result.Resolve(m_reachability ? m_reachability->online.load() : true);
+}
+
+void NetworkModule::prefetchHosts(std::vector<std::string> hosts) noexcept {
+  if (!m_winsockReady)
+    return;
+
+  ADDRINFOEXW hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  for (const auto &host : hosts) {
+    auto wideHost = Utf8ToUtf16(host);
+    if (!wideHost || wideHost->empty())
+      continue;
+
+    // Lookups run on the system resolver's threads; results land in the DNS
+    // Client cache (TTL-respecting and shared across launches), so all we do
+    // here is free them.
+    auto *request = new PrefetchRequest();
+    request->host = std::move(*wideHost);
+    request->state = m_prefetches;
+    INT status;
+    {
+      // Held across the call so the completion routine can't free the
+      // request before GetAddrInfoExW has stored its cancel handle.
+      std::lock_guard<std::mutex> lock(m_prefetches->mutex);
+      m_prefetches->pending.insert(request);
+      status = GetAddrInfoExW(request->host.c_str(), L"443", NS_DNS, nullptr,
+                              &hints, &request->result, nullptr,
+                              &request->overlapped, OnPrefetchComplete,
+                              &request->cancel);
+    }
+    // Anything but WSA_IO_PENDING finished (or failed) synchronously, in which
+    // case the completion routine is not invoked.
+    if (status != WSA_IO_PENDING)
+      OnPrefetchComplete(0, 0, &request->overlapped);
+  }
+}
+
+} // namespace StarterApp
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "pch.h"
+#include "NativeModules.h"
+#include <winrt/Microsoft.ReactNative.h>
+#include <winrt/Windows.Networking.Connectivity.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace StarterApp {
+
+struct PrefetchState;
+
+REACT_MODULE(NetworkModule)
+struct NetworkModule {
+  REACT_INIT(Initialize)
+  void Initialize(winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept;
+
+  ~NetworkModule() noexcept;
+
+  // Starts asynchronous DNS lookups for `hosts` so the system resolver cache
+  // is warm before the first request. Fire-and-forget.
+  REACT_METHOD(prefetchHosts)
+  void prefetchHosts(std::vector<std::string> hosts) noexcept;
+
+  // Resolves with whether the machine currently has internet access.
+  REACT_METHOD(getReachability)
+  void getReachability(React::ReactPromise<bool> result) noexcept;
+
+  // Emitted (as a DeviceEventEmitter event) whenever internet access is
+  // gained or lost.
+  REACT_EVENT(onReachabilityChanged, L"reachabilityChanged")
+  std::function<void(bool)> onReachabilityChanged;
+
+ private:
+  // Shared with the NetworkStatusChanged handler and the initial query,
+  // which may outlive the module.
+  struct ReachabilityState {
+    std::atomic<bool> online{true}; // until the first query says otherwise
+    std::mutex mutex;
+    std::function<void(bool)> onChanged; // cleared by the destructor
+  };
+
+  static bool IsInternetAvailable() noexcept;
+  static void UpdateReachability(std::weak_ptr<ReachabilityState> weakState) noexcept;
+
+  winrt::Microsoft::ReactNative::ReactContext m_reactContext;
+  bool m_winsockReady{false};
+  // In-flight prefetchHosts lookups, cancelled by the destructor.
+  std::shared_ptr<PrefetchState> m_prefetches;
+  std::shared_ptr<ReachabilityState> m_reachability;
+  winrt::event_token m_statusChangedToken{};
+};
+
+} // namespace StarterApp
@@ -0,0 +1,56 @@
+#include "Occlusion.h"
+
+#include <algorithm>
+
+namespace StarterApp {
+
+namespace {
+
+bool IsEmpty(const ScreenRect &rect) {
+  return rect.left >= rect.right || rect.top >= rect.bottom;
+}
+
+// Appends the parts of `rect` outside `cut` (at most four) to `out`.
+void Subtract(const ScreenRect &rect, const ScreenRect &cut,
+              std::vector<ScreenRect> &out) {
+  ScreenRect overlap{std::max(rect.left, cut.left),
+                     std::max(rect.top, cut.top),
+                     std::min(rect.right, cut.right),
+                     std::min(rect.bottom, cut.bottom)};
+  if (IsEmpty(overlap)) {
+    out.push_back(rect);
+    return;
+  }
+  // Full-width bands above and below the overlap, then the sides.
+  if (rect.top < overlap.top)
+    out.push_back({rect.left, rect.top, rect.right, overlap.top});
+  if (overlap.bottom < rect.bottom)
+    out.push_back({rect.left, overlap.bottom, rect.right, rect.bottom});
+  if (rect.left < overlap.left)
+    out.push_back({rect.left, overlap.top, overlap.left, overlap.bottom});
+  if (overlap.right < rect.right)
+    out.push_back({overlap.right, overlap.top, rect.right, overlap.bottom});
+}
+
+} // namespace
+
+bool IsFullyCovered(const ScreenRect &target,
+                    const std::vector<ScreenRect> &covers) {
+  std::vector<ScreenRect> visible;
+  if (!IsEmpty(target))
+    visible.push_back(target);
+  std::vector<ScreenRect> next;
+  for (const auto &cover : covers) {
+    if (visible.empty())
+      break;
+    if (IsEmpty(cover))
+      continue;
+    next.clear();
+    for (const auto &rect : visible)
+      Subtract(rect, cover, next);
+    visible.swap(next);
+  }
+  return visible.empty();
+}
+
+} // namespace StarterApp
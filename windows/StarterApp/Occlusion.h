@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace StarterApp {
+
+// Screen rectangle in pixels, right/bottom exclusive (like RECT).
+struct ScreenRect {
+  int32_t left;
+  int32_t top;
+  int32_t right;
+  int32_t bottom;
+};
+
+// Whether the union of `covers` contains every pixel of `target`. An empty
+// target counts as covered (nothing of it can be seen). Kept free of Win32
+// so it can be tested on its own; see OcclusionMonitor.h for the caller.
+bool IsFullyCovered(const ScreenRect &target,
+                    const std::vector<ScreenRect> &covers);
+
+} // namespace StarterApp
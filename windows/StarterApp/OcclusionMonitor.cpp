@@ -0,0 +1,144 @@
+#include "pch.h"
+#include "OcclusionMonitor.h"
+
+#include "Occlusion.h"
+
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#pragma comment(lib, "dwmapi.lib")
+
+namespace StarterApp {
+
+namespace {
+
+constexpr UINT kCheckDelayMs = 250;
+
+HWND g_window{nullptr};
+std::function<void(bool)> g_onChanged;
+bool g_occluded{false};
+std::vector<HWINEVENTHOOK> g_hooks;
+UINT_PTR g_timer{0};
+
+bool IsCloaked(HWND hwnd) {
+  DWORD cloaked = 0;
+  return SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked,
+                                         sizeof(cloaked))) &&
+         cloaked != 0;
+}
+
+// The visible frame, without the invisible resize borders GetWindowRect
+// includes.
+bool GetFrame(HWND hwnd, ScreenRect &frame) {
+  RECT rect;
+  if (FAILED(DwmGetWindowAttribute(hwnd, DWMWA_EXTENDED_FRAME_BOUNDS, &rect,
+                                   sizeof(rect))) &&
+      !GetWindowRect(hwnd, &rect))
+    return false;
+  frame = {static_cast<int32_t>(rect.left), static_cast<int32_t>(rect.top),
+           static_cast<int32_t>(rect.right), static_cast<int32_t>(rect.bottom)};
+  return true;
+}
+
+bool IsOccluded(HWND hwnd) {
+  if (IsCloaked(hwnd))
+    return true;
+  ScreenRect frame;
+  if (!GetFrame(hwnd, frame))
+    return false;
+
+  // Only the on-screen part of the window can be seen.
+  int32_t left = GetSystemMetrics(SM_XVIRTUALSCREEN);
+  int32_t top = GetSystemMetrics(SM_YVIRTUALSCREEN);
+  frame.left = std::max(frame.left, left);
+  frame.top = std::max(frame.top, top);
+  frame.right =
+      std::min(frame.right, left + GetSystemMetrics(SM_CXVIRTUALSCREEN));
+  frame.bottom =
+      std::min(frame.bottom, top + GetSystemMetrics(SM_CYVIRTUALSCREEN));
+
+  // Top-level windows above ours, nearest first.
+  std::vector<ScreenRect> covers;
+  for (HWND above = GetWindow(hwnd, GW_HWNDPREV); above;
+       above = GetWindow(above, GW_HWNDPREV)) {
+    if (!IsWindowVisible(above) || IsIconic(above) || IsCloaked(above))
+      continue;
+    if (GetWindowLongW(above, GWL_EXSTYLE) & (WS_EX_LAYERED | WS_EX_TRANSPARENT))
+      continue;
+    ScreenRect cover;
+    if (GetFrame(above, cover))
+      covers.push_back(cover);
+  }
+  return IsFullyCovered(frame, covers);
+}
+
+void CALLBACK OnCheckTimer(HWND, UINT, UINT_PTR, DWORD) {
+  KillTimer(nullptr, g_timer);
+  g_timer = 0;
+  if (!g_window)
+    return;
+  bool occluded = IsOccluded(g_window);
+  if (occluded == g_occluded)
+    return;
+  g_occluded = occluded;
+  g_onChanged(occluded);
+}
+
+// Coalesces bursts of events (a window drag reports every step) into one
+// check.
+void ScheduleCheck() {
+  if (g_timer == 0)
+    g_timer = SetTimer(nullptr, 0, kCheckDelayMs, OnCheckTimer);
+}
+
+void CALLBACK OnWinEvent(HWINEVENTHOOK, DWORD, HWND hwnd, LONG idObject,
+                         LONG idChild, DWORD, DWORD) {
+  // Only whole windows; caret and cursor moves also report location changes.
+  if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || !hwnd)
+    return;
+  if (GetAncestor(hwnd, GA_ROOT) != hwnd)
+    return;
+  ScheduleCheck();
+}
+
+} // namespace
+
+void StartOcclusionMonitor(HWND hwnd,
+                           std::function<void(bool occluded)> onChanged) {
+  StopOcclusionMonitor();
+  g_window = hwnd;
+  g_onChanged = std::move(onChanged);
+  g_occluded = false;
+  // Narrow ranges: an out-of-context hook gets a message per event.
+  const std::pair<DWORD, DWORD> ranges[] = {
+      // Foreground, move / size and minimize / restore
+      {EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_MINIMIZEEND},
+      // Show, hide and z-order
+      {EVENT_OBJECT_SHOW, EVENT_OBJECT_REORDER},
+      {EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE},
+      {EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED},
+  };
+  for (const auto &[first, last] : ranges) {
+    if (HWINEVENTHOOK hook = SetWinEventHook(first, last, nullptr, OnWinEvent,
+                                             0, 0, WINEVENT_OUTOFCONTEXT))
+      g_hooks.push_back(hook);
+  }
+  ScheduleCheck();
+}
+
+void StopOcclusionMonitor() noexcept {
+  for (HWINEVENTHOOK hook : g_hooks)
+    UnhookWinEvent(hook);
+  g_hooks.clear();
+  if (g_timer) {
+    KillTimer(nullptr, g_timer);
+    g_timer = 0;
+  }
+  g_window = nullptr;
+  g_onChanged = nullptr;
+}
+
+} // namespace StarterApp
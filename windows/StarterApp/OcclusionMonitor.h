@@ -0,0 +1,20 @@
+#pragma once
+
+#include "pch.h"
+
+#include <functional>
+
+namespace StarterApp {
+
+// Watches whether `hwnd` is occluded: cloaked (e.g. on another virtual
+// desktop) or entirely covered by other visible top-level windows, clipped
+// to the screen. Window moves, z-order and cloaking changes are observed
+// with WinEvent hooks and re-checked at most every 250 ms; `onChanged`
+// runs on the calling thread, which must pump messages, whenever the result
+// changes. Translucent (layered) windows never count as covering. Call both
+// functions on the same thread.
+void StartOcclusionMonitor(HWND hwnd,
+                           std::function<void(bool occluded)> onChanged);
+void StopOcclusionMonitor() noexcept;
+
+} // namespace StarterApp
@@ -0,0 +1,179 @@
+#include "ProfileWriter.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace StarterApp {
+
+namespace {
+
+// Folded-stack frames are separated by ';' and the count by the last space.
+std::string FoldedFrame(std::string frame) {
+  for (char &c : frame) {
+    if (c == ';')
+      c = ':';
+  }
+  return frame;
+}
+
+// Just enough of the protobuf wire format for profile.proto.
+class ProtoWriter {
+ public:
+  void Uint(int field, uint64_t value) {
+    Tag(field, 0);
+    Varint(value);
+  }
+
+  void Bytes(int field, std::string_view bytes) {
+    Tag(field, 2);
+    Varint(bytes.size());
+    m_data.append(bytes);
+  }
+
+  void Message(int field, const ProtoWriter &message) {
+    Bytes(field, message.m_data);
+  }
+
+  void Packed(int field, const std::vector<uint64_t> &values) {
+    ProtoWriter packed;
+    for (uint64_t value : values)
+      packed.Varint(value);
+    Bytes(field, packed.m_data);
+  }
+
+  const std::string &data() const {
+    return m_data;
+  }
+
+ private:
+  void Tag(int field, int wireType) {
+    Varint((static_cast<uint64_t>(field) << 3) | wireType);
+  }
+
+  void Varint(uint64_t value) {
+    while (value >= 0x80) {
+      m_data.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    m_data.push_back(static_cast<char>(value));
+  }
+
+  std::string m_data;
+};
+
+} // namespace
+
+uint64_t ProfileData::AddThread(std::string name) {
+  uint64_t key = threads.empty() ? 1 : threads.rbegin()->first + 1;
+  threads[key].name = std::move(name);
+  return key;
+}
+
+void ProfileData::AddSample(uint64_t thread, const uint64_t *frames,
+                            size_t depth) {
+  if (depth == 0)
+    return;
+  threads[thread].stacks[std::vector<uint64_t>(frames, frames + depth)]++;
+}
+
+void WriteFolded(std::ostream &out, const ProfileData &profile,
+                 const Symbolizer &symbolize) {
+  std::unordered_map<uint64_t, std::string> names;
+  for (const auto &[key, thread] : profile.threads) {
+    const std::string threadName = FoldedFrame(thread.name);
+    for (const auto &[frames, count] : thread.stacks) {
+      out << threadName;
+      // Folded stacks list the outermost frame first.
+      for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+        auto name = names.find(*it);
+        if (name == names.end())
+          name = names.emplace(*it, FoldedFrame(symbolize(*it))).first;
+        out << ';' << name->second;
+      }
+      out << ' ' << count << '\n';
+    }
+  }
+}
+
+void WritePprof(std::ostream &out, const ProfileData &profile,
+                const Symbolizer &symbolize) {
+  std::vector<std::string> strings{""};
+  std::unordered_map<std::string, uint64_t> stringIds{{"", 0}};
+  auto stringId = [&](const std::string &value) {
+    auto [it, inserted] = stringIds.emplace(value, strings.size());
+    if (inserted)
+      strings.push_back(value);
+    return it->second;
+  };
+
+  ProtoWriter message;
+  auto valueType = [&](const char *type, const char *unit) {
+    ProtoWriter vt;
+    vt.Uint(1, stringId(type));
+    vt.Uint(2, stringId(unit));
+    return vt;
+  };
+  const uint64_t periodNs = static_cast<uint64_t>(profile.intervalMs) * 1000000;
+  message.Message(1, valueType("samples", "count"));
+  message.Message(1, valueType("cpu", "nanoseconds"));
+
+  // One location per address, one function per symbol name.
+  std::unordered_map<uint64_t, uint64_t> locationIds;
+  std::unordered_map<std::string, uint64_t> functionIds;
+  auto locationId = [&](uint64_t address) {
+    auto [it, inserted] = locationIds.emplace(address, locationIds.size() + 1);
+    if (!inserted)
+      return it->second;
+    std::string name = symbolize(address);
+    auto [fn, newFunction] =
+        functionIds.emplace(name, functionIds.size() + 1);
+    if (newFunction) {
+      ProtoWriter function;
+      function.Uint(1, fn->second);
+      function.Uint(2, stringId(name));
+      function.Uint(3, stringId(name));
+      message.Message(5, function);
+    }
+    ProtoWriter line;
+    line.Uint(1, fn->second);
+    ProtoWriter location;
+    location.Uint(1, it->second);
+    location.Uint(3, address);
+    location.Message(4, line);
+    message.Message(4, location);
+    return it->second;
+  };
+
+  const uint64_t threadKey = stringId("thread");
+  for (const auto &[key, thread] : profile.threads) {
+    const uint64_t threadName = stringId(thread.name);
+    for (const auto &[frames, count] : thread.stacks) {
+      // pprof lists the leaf first, as captured.
+      std::vector<uint64_t> ids;
+      ids.reserve(frames.size());
+      for (uint64_t address : frames)
+        ids.push_back(locationId(address));
+      ProtoWriter label;
+      label.Uint(1, threadKey);
+      label.Uint(2, threadName);
+      ProtoWriter sample;
+      sample.Packed(1, ids);
+      sample.Packed(2, {count, count * periodNs});
+      sample.Message(3, label);
+      message.Message(2, sample);
+    }
+  }
+
+  message.Uint(9, profile.startedAtNs);
+  message.Uint(10, profile.durationNs);
+  message.Message(11, valueType("cpu", "nanoseconds"));
+  message.Uint(12, periodNs);
+  // The string table comes last so every string above is in it.
+  for (const auto &value : strings)
+    message.Bytes(6, value);
+
+  out.write(message.data().data(),
+            static_cast<std::streamsize>(message.data().size()));
+}
+
+} // namespace StarterApp
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace StarterApp {
+
+// Stack samples aggregated per thread and unique stack, and the writers for
+// the profile formats. Kept free of Win32 (capture and symbols live in
+// Profiler.cpp) so it can be tested on its own.
+struct ProfileData {
+  struct Thread {
+    std::string name;
+    // Stack (innermost frame first) -> number of samples.
+    std::map<std::vector<uint64_t>, uint32_t> stacks;
+  };
+
+  // By a key local to this profile, not the OS thread id: the system reuses
+  // ids, and a new thread must not inherit an exited one's samples.
+  std::map<uint64_t, Thread> threads;
+  uint32_t intervalMs{0};
+  uint64_t startedAtNs{0}; // Unix epoch
+  uint64_t durationNs{0};
+
+  // Returns the key of a new thread.
+  uint64_t AddThread(std::string name);
+
+  // Counts one sample of `frames` (innermost first) on `thread`. Empty
+  // stacks are ignored.
+  void AddSample(uint64_t thread, const uint64_t *frames, size_t depth);
+};
+
+// `module!symbol+0xoffset`, or whatever is known, for a code address.
+using Symbolizer = std::function<std::string(uint64_t address)>;
+
+// Writes an uncompressed perftools.profiles.Profile (`go tool pprof`
+// accepts plain and gzipped input). Each sample counts as one interval of
+// CPU time; the sampler only records threads that ran since the previous
+// tick, so the `cpu` value approximates on-CPU time.
+void WritePprof(std::ostream &out, const ProfileData &profile,
+                const Symbolizer &symbolize);
+
+// Writes one `thread;outer;...;inner count` line per unique stack, as
+// consumed by flamegraph.pl and speedscope.
+void WriteFolded(std::ostream &out, const ProfileData &profile,
+                 const Symbolizer &symbolize);
+
+} // namespace StarterApp
@@ -0,0 +1,453 @@
+#include "pch.h"
+#include "Profiler.h"
+
+#include "ProfileWriter.h"
+#include "Utf.h"
+
+#include <dbghelp.h>
+#include <tlhelp32.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#pragma comment(lib, "dbghelp.lib")
+
+namespace StarterApp {
+
+namespace {
+
+// How often the sampler re-enumerates the process's threads.
+constexpr ULONGLONG kThreadRefreshMs = 250;
+constexpr uint32_t kMinIntervalMs = 5;
+constexpr uint32_t kMaxIntervalMs = 1000;
+
+// Upper bound on the live stack copied per sample; deeper stacks are
+// truncated at the outermost end.
+constexpr size_t kStackCopyBytes = 512 * 1024;
+
+struct ProfiledThread {
+  HANDLE handle{nullptr};
+  uintptr_t stackBase{0};
+  uint64_t key{0}; // in ProfileData::threads
+  ULONG64 cycles{0}; // at the last tick
+};
+
+// Written only by the sampler thread while it runs and read only after it
+// has been joined, so samples need no locking.
+struct Profile {
+  // Threads currently alive, by OS thread id.
+  std::unordered_map<DWORD, ProfiledThread> live;
+  ProfileData data;
+  ULONGLONG startTick{0};
+};
+
+std::mutex g_controlMutex;
+std::thread g_sampler;
+std::atomic<bool> g_running{false};
+HANDLE g_stopEvent{nullptr};
+Profile g_profile;
+
+// dbghelp is single-threaded.
+std::mutex g_symbolMutex;
+bool g_symbolsInitialized{false};
+
+// Kept free of C++ objects so it can use SEH: the target may have moved its
+// stack pointer somewhere unexpected.
+bool CopyStack(uint64_t *destination, uintptr_t source, size_t bytes) noexcept {
+  __try {
+    memcpy(destination, reinterpret_cast<const void *>(source), bytes);
+    return true;
+  } __except (EXCEPTION_EXECUTE_HANDLER) {
+    return false;
+  }
+}
+
+#if defined(_M_X64) || defined(_M_ARM64)
+
+uintptr_t StackPointer(const CONTEXT &context) {
+#if defined(_M_X64)
+  return context.Rsp;
+#else
+  return context.Sp;
+#endif
+}
+
+// Points the copied stack's saved frame pointers, and the registers that
+// may hold stack addresses, at the copy so the unwinder never reads the
+// live stack. Like any conservative rewrite this also shifts non-pointer
+// values that happen to fall in the range; the unwinder doesn't care.
+void RelocateStack(CONTEXT &context, uint64_t *copy, uintptr_t top,
+                   size_t bytes) {
+  const uint64_t delta = reinterpret_cast<uintptr_t>(copy) - top;
+  auto relocate = [&](DWORD64 &value) {
+    if (value >= top && value < top + bytes)
+      value += delta;
+  };
+  for (size_t i = 0; i < bytes / sizeof(uint64_t); i++)
+    relocate(copy[i]);
+#if defined(_M_X64)
+  for (DWORD64 *reg : {&context.Rsp, &context.Rbp, &context.Rbx, &context.Rsi,
+                       &context.Rdi, &context.R12, &context.R13, &context.R14,
+                       &context.R15})
+    relocate(*reg);
+#else
+  relocate(context.Sp);
+  relocate(context.Fp);
+  for (int i = 19; i <= 28; i++)
+    relocate(context.X[i]);
+#endif
+}
+
+// Walks a relocated stack copy in [low, high). Kept free of C++ objects so
+// it can use SEH: a corrupt or non-standard frame may make the walk read
+// outside the copy.
+size_t UnwindStack(CONTEXT *context, uintptr_t low, uintptr_t high,
+                   uint64_t *frames, size_t maxFrames) noexcept {
+  size_t count = 0;
+  __try {
+#if defined(_M_X64)
+    while (count < maxFrames && context->Rip != 0) {
+      frames[count++] = context->Rip;
+      if (context->Rsp < low || context->Rsp + sizeof(DWORD64) > high)
+        break;
+      DWORD64 imageBase = 0;
+      PRUNTIME_FUNCTION function =
+          RtlLookupFunctionEntry(context->Rip, &imageBase, nullptr);
+      if (function == nullptr) {
+        // Leaf function: the return address is on top of the stack.
+        context->Rip = *reinterpret_cast<DWORD64 *>(context->Rsp);
+        context->Rsp += sizeof(DWORD64);
+      } else {
+        PVOID handlerData = nullptr;
+        DWORD64 establisherFrame = 0;
+        RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context->Rip, function,
+                         context, &handlerData, &establisherFrame, nullptr);
+      }
+    }
+#else
+    while (count < maxFrames && context->Pc != 0) {
+      frames[count++] = context->Pc;
+      if (context->Sp < low || context->Sp >= high)
+        break;
+      DWORD64 imageBase = 0;
+      PRUNTIME_FUNCTION function =
+          RtlLookupFunctionEntry(context->Pc, &imageBase, nullptr);
+      if (function == nullptr) {
+        // Leaf function: the return address is still in the link register.
+        if (context->Pc == context->Lr)
+          break;
+        context->Pc = context->Lr;
+      } else {
+        PVOID handlerData = nullptr;
+        DWORD64 establisherFrame = 0;
+        RtlVirtualUnwind(UNW_FLAG_NHANDLER, imageBase, context->Pc, function,
+                         context, &handlerData, &establisherFrame, nullptr);
+      }
+    }
+#endif
+  } __except (EXCEPTION_EXECUTE_HANDLER) {
+  }
+  return count;
+}
+
+#endif // defined(_M_X64) || defined(_M_ARM64)
+
+std::string ThreadName(HANDLE thread, DWORD threadId) {
+  PWSTR description = nullptr;
+  std::string name;
+  if (SUCCEEDED(GetThreadDescription(thread, &description)) && description) {
+    name = Utf16ToUtf8(description).value_or("");
+    LocalFree(description);
+  }
+  if (name.empty())
+    name = "thread-" + std::to_string(threadId);
+  return name;
+}
+
+// Closes the handles of threads that exited, then opens handles for threads
+// that appeared since the last refresh. Exited threads are dropped first, so
+// a new thread that reuses an exited one's id gets its own entry.
+void RefreshThreads(Profile &profile, DWORD selfId) {
+  for (auto it = profile.live.begin(); it != profile.live.end();) {
+    if (WaitForSingleObject(it->second.handle, 0) == WAIT_OBJECT_0) {
+      CloseHandle(it->second.handle);
+      it = profile.live.erase(it); // its samples stay in profile.data
+    } else {
+      ++it;
+    }
+  }
+
+  HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+  if (snapshot == INVALID_HANDLE_VALUE)
+    return;
+
+  DWORD processId = GetCurrentProcessId();
+  THREADENTRY32 entry{};
+  entry.dwSize = sizeof(entry);
+  for (BOOL ok = Thread32First(snapshot, &entry); ok;
+       ok = Thread32Next(snapshot, &entry)) {
+    if (entry.th32OwnerProcessID != processId ||
+        entry.th32ThreadID == selfId ||
+        profile.live.count(entry.th32ThreadID))
+      continue;
+    HANDLE handle = OpenThread(SYNCHRONIZE | THREAD_SUSPEND_RESUME |
+                                   THREAD_GET_CONTEXT |
+                                   THREAD_QUERY_INFORMATION,
+                               FALSE, entry.th32ThreadID);
+    if (!handle)
+      continue;
+    ProfiledThread thread{handle, StackSampler::StackBase(handle),
+                          profile.data.AddThread(
+                              ThreadName(handle, entry.th32ThreadID))};
+    QueryThreadCycleTime(handle, &thread.cycles);
+    profile.live[entry.th32ThreadID] = thread;
+  }
+  CloseHandle(snapshot);
+}
+
+uint64_t UnixTimeNs() {
+  FILETIME now;
+  GetSystemTimeAsFileTime(&now);
+  uint64_t ticks =
+      (static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+  // FILETIME counts 100ns ticks from 1601-01-01.
+  constexpr uint64_t kUnixEpochTicks = 116444736000000000ULL;
+  return (ticks - kUnixEpochTicks) * 100;
+}
+
+void SamplerLoop(uint32_t intervalMs) {
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+  SetThreadDescription(GetCurrentThread(), L"StarterApp profiler");
+
+  // A high-resolution timer gives accurate intervals without raising the
+  // system-wide timer resolution; older systems fall back to the default
+  // tick, which stretches short intervals to ~15.6 ms.
+  HANDLE timer = CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  if (timer == nullptr)
+    timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  if (timer == nullptr)
+    return;
+  LARGE_INTEGER dueTime;
+  dueTime.QuadPart = -static_cast<LONGLONG>(intervalMs) * 10000;
+  SetWaitableTimer(timer, &dueTime, static_cast<LONG>(intervalMs), nullptr,
+                   nullptr, FALSE);
+
+  StackSampler sampler;
+  DWORD selfId = GetCurrentThreadId();
+  ULONGLONG lastRefresh = 0;
+  uint64_t frames[kMaxStackFrames];
+  HANDLE waits[] = {g_stopEvent, timer};
+
+  while (WaitForMultipleObjects(2, waits, FALSE, INFINITE) ==
+         WAIT_OBJECT_0 + 1) {
+    ULONGLONG now = GetTickCount64();
+    if (now - lastRefresh >= kThreadRefreshMs) {
+      RefreshThreads(g_profile, selfId);
+      lastRefresh = now;
+    }
+
+    for (auto &[threadId, thread] : g_profile.live) {
+      // Only threads that ran since the last tick: a blocked or idle thread
+      // would otherwise fill the CPU profile with its wait.
+      ULONG64 cycles = 0;
+      if (QueryThreadCycleTime(thread.handle, &cycles)) {
+        if (cycles == thread.cycles)
+          continue;
+        thread.cycles = cycles;
+      }
+      size_t depth = sampler.Capture(thread.handle, thread.stackBase, frames,
+                                     kMaxStackFrames);
+      g_profile.data.AddSample(thread.key, frames, depth);
+    }
+  }
+
+  CancelWaitableTimer(timer);
+  CloseHandle(timer);
+  for (auto &[threadId, thread] : g_profile.live)
+    CloseHandle(thread.handle);
+  g_profile.live.clear();
+}
+
+void EnsureSymbols() {
+  if (g_symbolsInitialized)
+    return;
+  SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS);
+  SymInitialize(GetCurrentProcess(), nullptr, TRUE);
+  g_symbolsInitialized = true;
+}
+
+// `module!symbol+0xoffset`, `module+0xoffset` or `0xaddress`. Requires
+// g_symbolMutex.
+std::string SymbolizeAddress(uint64_t address) {
+  char buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME];
+  auto *symbol = reinterpret_cast<SYMBOL_INFO *>(buffer);
+  symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+  symbol->MaxNameLen = MAX_SYM_NAME;
+
+  IMAGEHLP_MODULE64 module{};
+  module.SizeOfStruct = sizeof(module);
+  bool hasModule = SymGetModuleInfo64(GetCurrentProcess(), address, &module);
+
+  char offset[32];
+  DWORD64 displacement = 0;
+  if (SymFromAddr(GetCurrentProcess(), address, &displacement, symbol)) {
+    snprintf(offset, sizeof(offset), "+0x%llx",
+             static_cast<unsigned long long>(displacement));
+    return (hasModule ? std::string(module.ModuleName) + "!" : "") +
+           std::string(symbol->Name, symbol->NameLen) + offset;
+  }
+  if (hasModule) {
+    snprintf(offset, sizeof(offset), "+0x%llx",
+             static_cast<unsigned long long>(address - module.BaseOfImage));
+    return std::string(module.ModuleName) + offset;
+  }
+  snprintf(offset, sizeof(offset), "0x%llx",
+           static_cast<unsigned long long>(address));
+  return offset;
+}
+
+} // namespace
+
+StackSampler::StackSampler()
+    : m_stackCopy(new uint64_t[kStackCopyBytes / sizeof(uint64_t)]) {}
+
+uintptr_t StackSampler::StackBase(HANDLE thread) noexcept {
+  // THREAD_BASIC_INFORMATION; only the TEB address is needed.
+  struct ThreadBasicInformation {
+    LONG exitStatus;
+    PVOID tebBaseAddress;
+    HANDLE clientId[2];
+    ULONG_PTR affinityMask;
+    LONG priority;
+    LONG basePriority;
+  };
+  using NtQueryInformationThreadFn =
+      LONG(NTAPI *)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+  static const auto queryInformation =
+      reinterpret_cast<NtQueryInformationThreadFn>(GetProcAddress(
+          GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationThread"));
+
+  ThreadBasicInformation info{};
+  if (queryInformation == nullptr ||
+      queryInformation(thread, 0 /* ThreadBasicInformation */, &info,
+                       sizeof(info), nullptr) < 0 ||
+      info.tebBaseAddress == nullptr)
+    return 0;
+  // The TEB starts with the NT_TIB, which records the stack bounds.
+  return reinterpret_cast<uintptr_t>(
+      static_cast<NT_TIB *>(info.tebBaseAddress)->StackBase);
+}
+
+size_t StackSampler::Capture(HANDLE thread, uintptr_t stackBase,
+                             uint64_t *frames, size_t maxFrames) noexcept {
+  CONTEXT context{};
+  context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+  if (SuspendThread(thread) == static_cast<DWORD>(-1))
+    return 0;
+
+#if defined(_M_X64) || defined(_M_ARM64)
+  // Only registers and a memcpy while the target is suspended.
+  uintptr_t top = 0;
+  size_t copied = 0;
+  if (GetThreadContext(thread, &context)) {
+    top = StackPointer(context);
+    if (top != 0 && top < stackBase) {
+      size_t bytes = std::min(stackBase - top, kStackCopyBytes) &
+                     ~(sizeof(uint64_t) - 1);
+      if (CopyStack(m_stackCopy.get(), top, bytes))
+        copied = bytes;
+    }
+  }
+  ResumeThread(thread);
+  if (copied == 0)
+    return 0;
+
+  // The target is running again, so the unwinder may take its locks.
+  RelocateStack(context, m_stackCopy.get(), top, copied);
+  uintptr_t low = reinterpret_cast<uintptr_t>(m_stackCopy.get());
+  return UnwindStack(&context, low, low + copied, frames, maxFrames);
+#else
+  // No table-based unwinding on x86; record the current location only.
+  size_t count = 0;
+  if (GetThreadContext(thread, &context) && maxFrames > 0 && context.Eip != 0)
+    frames[count++] = context.Eip;
+  ResumeThread(thread);
+  return count;
+#endif
+}
+
+std::string SymbolizeStack(const uint64_t *frames, size_t count) {
+  std::lock_guard<std::mutex> lock(g_symbolMutex);
+  EnsureSymbols();
+  std::string result;
+  for (size_t i = 0; i < count; i++) {
+    result += "  ";
+    result += SymbolizeAddress(frames[i]);
+    result += '\n';
+  }
+  return result;
+}
+
+bool StartProfiler(uint32_t intervalMs) noexcept {
+  std::lock_guard<std::mutex> lock(g_controlMutex);
+  if (g_running.load())
+    return false;
+  g_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (g_stopEvent == nullptr)
+    return false;
+  g_profile = Profile{};
+  g_profile.data.intervalMs =
+      intervalMs == 0 ? kDefaultProfilerIntervalMs
+                      : std::clamp(intervalMs, kMinIntervalMs, kMaxIntervalMs);
+  g_profile.data.startedAtNs = UnixTimeNs();
+  g_profile.startTick = GetTickCount64();
+  g_running = true;
+  g_sampler = std::thread(SamplerLoop, g_profile.data.intervalMs);
+  return true;
+}
+
+std::wstring StopProfiler(ProfileFormat format) {
+  std::lock_guard<std::mutex> controlLock(g_controlMutex);
+  if (!g_running.load())
+    return {};
+  SetEvent(g_stopEvent);
+  g_sampler.join();
+  CloseHandle(g_stopEvent);
+  g_stopEvent = nullptr;
+  g_running = false;
+  g_profile.data.durationNs = (GetTickCount64() - g_profile.startTick) * 1000000;
+
+  WCHAR tempDir[MAX_PATH];
+  if (GetTempPathW(MAX_PATH, tempDir) == 0)
+    return {};
+  std::wstring path = std::wstring(tempDir) + L"StarterApp-" +
+                      std::to_wstring(GetCurrentProcessId()) + L"-" +
+                      std::to_wstring(GetTickCount64()) +
+                      (format == ProfileFormat::Pprof ? L".pb" : L".folded");
+  std::ofstream out(path, std::ios::binary);
+  if (!out)
+    return {};
+
+  {
+    std::lock_guard<std::mutex> symbolLock(g_symbolMutex);
+    EnsureSymbols();
+    if (format == ProfileFormat::Pprof)
+      WritePprof(out, g_profile.data, SymbolizeAddress);
+    else
+      WriteFolded(out, g_profile.data, SymbolizeAddress);
+  }
+  g_profile = Profile{};
+  return out ? path : std::wstring{};
+}
+
+bool IsProfilerRunning() noexcept {
+  return g_running.load();
+}
+
+} // namespace StarterApp
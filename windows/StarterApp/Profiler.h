@@ -0,0 +1,71 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace StarterApp {
+
+constexpr size_t kMaxStackFrames = 64;
+constexpr uint32_t kDefaultProfilerIntervalMs = 10;
+
+// Captures the call stacks of other threads in this process.
+//
+// The target is only suspended long enough to read its registers and copy
+// the live part of its stack into a preallocated buffer; it is resumed
+// before any unwinding happens. The unwinder (RtlLookupFunctionEntry /
+// RtlVirtualUnwind) takes the loader and function-table locks, so running
+// it while the target is suspended could deadlock if the target holds one.
+// While the target is suspended nothing here allocates, takes a lock or
+// calls into the loader.
+//
+// Not thread-safe: use one StackSampler per sampling thread.
+class StackSampler {
+ public:
+  StackSampler();
+
+  // Returns the base (highest address) of `thread`'s stack, or 0. `thread`
+  // needs THREAD_QUERY_INFORMATION access.
+  static uintptr_t StackBase(HANDLE thread) noexcept;
+
+  // Captures `thread`'s return addresses (innermost first) into `frames`.
+  // `thread` needs THREAD_SUSPEND_RESUME and THREAD_GET_CONTEXT access and
+  // must not be the calling thread; `stackBase` comes from StackBase() (or
+  // GetCurrentThreadStackLimits on the thread itself). Returns the number
+  // of frames captured (0 on failure).
+  size_t Capture(HANDLE thread, uintptr_t stackBase, uint64_t *frames,
+                 size_t maxFrames) noexcept;
+
+ private:
+  std::unique_ptr<uint64_t[]> m_stackCopy;
+};
+
+// Formats `frames` (innermost first) as `module!symbol+0xoffset` lines,
+// loading symbols on first use.
+std::string SymbolizeStack(const uint64_t *frames, size_t count);
+
+enum class ProfileFormat {
+  // Uncompressed pprof protobuf (`.pb`), as read by `go tool pprof`.
+  Pprof,
+  // One `thread;outer;...;inner count` line per unique stack, as consumed
+  // by flamegraph.pl and speedscope.
+  Folded,
+};
+
+// Starts sampling the threads of the process every `intervalMs`
+// milliseconds (clamped to 5..1000; 0 picks the default). Each tick samples
+// only the threads whose cycle count moved since the previous one, so the
+// profile shows CPU time rather than time spent waiting. Returns false if
+// the profiler is already running.
+bool StartProfiler(uint32_t intervalMs = kDefaultProfilerIntervalMs) noexcept;
+
+// Stops sampling and writes the profile to a file in the temp directory.
+// Returns the file's path, or an empty string if the profiler was not
+// running or the file could not be written.
+std::wstring StopProfiler(ProfileFormat format = ProfileFormat::Pprof);
+
+bool IsProfilerRunning() noexcept;
+
+} // namespace StarterApp
@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "AuthUiBackend.h"
+
+#include "Utf.h"
+
+#include <appmodel.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+namespace StarterApp {
+
+namespace {
+
+// Long enough for the user to pick an account, consent and finish a second
+// factor; an abandoned sign-in is normally ended sooner, by a retry or by
+// the user cancelling in the app.
+constexpr auto kAuthTimeout = std::chrono::minutes(2);
+
+std::mutex g_pendingMutex;
+std::condition_variable g_pendingChanged;
+// Id of the sign-in waiting for its redirect; 0 when none is.
+uint64_t g_pendingId{0};
+uint64_t g_nextId{1};
+std::string g_pendingScheme;
+std::optional<std::string> g_pendingUrl;
+
+bool SetRegistryString(HKEY key, const wchar_t *name,
+                       const std::wstring &value) {
+  return RegSetValueExW(key, name, 0, REG_SZ,
+                        reinterpret_cast<const BYTE *>(value.c_str()),
+                        static_cast<DWORD>((value.size() + 1) *
+                                           sizeof(wchar_t))) == ERROR_SUCCESS;
+}
+
+// Points `<scheme>:` URIs at this executable for the current user.
+bool RegisterScheme(const std::string &scheme) {
+  auto wideScheme = Utf8ToUtf16(scheme);
+  if (!wideScheme || wideScheme->empty())
+    return false;
+
+  WCHAR exePath[MAX_PATH];
+  GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+
+  std::wstring classKey = L"Software\\Classes\\" + *wideScheme;
+  HKEY key = nullptr;
+  if (RegCreateKeyExW(HKEY_CURRENT_USER, classKey.c_str(), 0, nullptr, 0,
+                      KEY_SET_VALUE, nullptr, &key,
+                      nullptr) != ERROR_SUCCESS)
+    return false;
+  bool ok = SetRegistryString(key, nullptr, L"URL:Starter App sign-in") &&
+            SetRegistryString(key, L"URL Protocol", L"");
+  RegCloseKey(key);
+  if (!ok)
+    return false;
+
+  std::wstring commandKey = classKey + L"\\shell\\open\\command";
+  if (RegCreateKeyExW(HKEY_CURRENT_USER, commandKey.c_str(), 0, nullptr, 0,
+                      KEY_SET_VALUE, nullptr, &key,
+                      nullptr) != ERROR_SUCCESS)
+    return false;
+  ok = SetRegistryString(key, nullptr,
+                         L"\"" + std::wstring(exePath) + L"\" \"%1\"");
+  RegCloseKey(key);
+  return ok;
+}
+
+bool HasScheme(const std::string &url, const std::string &scheme) {
+  if (url.size() <= scheme.size() || url[scheme.size()] != ':')
+    return false;
+  return std::equal(scheme.begin(), scheme.end(), url.begin(),
+                    [](char a, char b) {
+                      return std::tolower(static_cast<unsigned char>(a)) ==
+                             std::tolower(static_cast<unsigned char>(b));
+                    });
+}
+
+// Opens the authorization URL unchanged; its redirect_uri must already use
+// `<callbackScheme>:`.
+class ProtocolAuthUiBackend final : public IAuthUiBackend {
+ public:
+  const char *Name() const noexcept override { return "protocol"; }
+
+  AuthUiResult Authenticate(const std::string &url,
+                            const std::string &callbackScheme) override {
+    auto wUrl = Utf8ToUtf16(url);
+    if (!wUrl) {
+      return AuthUiResult::Error("INVALID_URL",
+                                 "Authorization URL is not valid UTF-8");
+    }
+    if (!RegisterScheme(callbackScheme)) {
+      return AuthUiResult::Error("REGISTRATION_ERROR",
+                                 "Failed to register the callback scheme");
+    }
+
+    // A new sign-in supersedes one still waiting (the user gave up on it in
+    // the browser and tried again); the earlier call returns Cancelled.
+    uint64_t id = 0;
+    {
+      std::lock_guard<std::mutex> lock(g_pendingMutex);
+      id = g_nextId++;
+      g_pendingId = id;
+      g_pendingScheme = callbackScheme;
+      g_pendingUrl.reset();
+    }
+    g_pendingChanged.notify_all();
+
+    ShellExecuteW(nullptr, L"open", wUrl->c_str(), nullptr, nullptr,
+                  SW_SHOWNORMAL);
+
+    std::unique_lock<std::mutex> lock(g_pendingMutex);
+    g_pendingChanged.wait_for(lock, kAuthTimeout, [id] {
+      return g_pendingId != id || g_pendingUrl.has_value();
+    });
+    if (g_pendingId != id)
+      return AuthUiResult::Cancelled(); // Superseded or cancelled
+    g_pendingId = 0;
+    std::optional<std::string> callbackUrl = std::move(g_pendingUrl);
+    g_pendingUrl.reset();
+    if (!callbackUrl)
+      return AuthUiResult::Cancelled();
+    return AuthUiResult{std::move(callbackUrl)};
+  }
+
+  void Cancel() noexcept override {
+    {
+      std::lock_guard<std::mutex> lock(g_pendingMutex);
+      if (g_pendingId == 0 || g_pendingUrl)
+        return;
+      g_pendingId = 0;
+    }
+    g_pendingChanged.notify_all();
+  }
+};
+
+} // namespace
+
+std::shared_ptr<IAuthUiBackend> CreateProtocolAuthUiBackend() {
+  return std::make_shared<ProtocolAuthUiBackend>();
+}
+
+bool CanUseProtocolAuthUi() noexcept {
+  UINT32 length = 0;
+  return GetCurrentPackageFullName(&length, nullptr) ==
+         APPMODEL_ERROR_NO_PACKAGE;
+}
+
+bool DeliverAuthActivation(const std::string &url) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(g_pendingMutex);
+    if (g_pendingId == 0 || g_pendingUrl || !HasScheme(url, g_pendingScheme))
+      return false;
+    g_pendingUrl = url;
+  }
+  g_pendingChanged.notify_all();
+  return true;
+}
+
+} // namespace StarterApp
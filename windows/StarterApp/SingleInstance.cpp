@@ -0,0 +1,237 @@
+#include "pch.h"
+#include "SingleInstance.h"
+
+#include "ThreadQos.h"
+#include "Utf.h"
+
+#include <sddl.h>
+
+#include <atomic>
+#include <optional>
+#include <thread>
+
+namespace StarterApp {
+
+namespace {
+
+// Activations carry a few short arguments (typically one URL).
+constexpr DWORD kMaxPayloadBytes = 64 * 1024;
+// How long a second launch keeps trying to reach a primary that is still
+// starting up or busy with another activation.
+constexpr ULONGLONG kConnectTimeoutMs = 5000;
+constexpr DWORD kConnectRetryMs = 50;
+
+HANDLE g_mutex{nullptr};
+// Created with the mutex, before the window, so a second launch always
+// finds the pipe; the listener thread serves it once started.
+HANDLE g_firstPipe{INVALID_HANDLE_VALUE};
+std::thread g_listener;
+std::atomic<bool> g_stopping{false};
+
+// Scoped to the logon session so separate users (or RDP sessions) each get
+// their own instance.
+std::wstring PipeName() {
+  DWORD sessionId = 0;
+  ProcessIdToSessionId(GetCurrentProcessId(), &sessionId);
+  return L"\\\\.\\pipe\\StarterApp.Activation." + std::to_wstring(sessionId);
+}
+
+// Payload: UTF-16 arguments, each terminated by L'\0'.
+// Returns nullopt if any argument is not valid UTF-16: dropping just that
+// one would shift the positions of the others.
+std::optional<std::vector<std::string>> DecodePayload(
+    const std::vector<wchar_t> &payload) {
+  std::vector<std::string> args;
+  size_t start = 0;
+  for (size_t i = 0; i < payload.size(); i++) {
+    if (payload[i] == L'\0') {
+      auto arg = Utf16ToUtf8({payload.data() + start, i - start});
+      if (!arg)
+        return std::nullopt;
+      args.push_back(std::move(*arg));
+      start = i + 1;
+    }
+  }
+  return args;
+}
+
+// Reads one message from a connected pipe.
+bool ReadMessage(HANDLE pipe, std::vector<wchar_t> &payload) {
+  std::vector<char> buffer;
+  char chunk[4096];
+  for (;;) {
+    DWORD read = 0;
+    BOOL ok = ReadFile(pipe, chunk, sizeof(chunk), &read, nullptr);
+    if (!ok && GetLastError() != ERROR_MORE_DATA)
+      return false;
+    buffer.insert(buffer.end(), chunk, chunk + read);
+    if (buffer.size() > kMaxPayloadBytes)
+      return false;
+    if (ok)
+      break;
+  }
+  payload.assign(reinterpret_cast<const wchar_t *>(buffer.data()),
+                 reinterpret_cast<const wchar_t *>(buffer.data()) +
+                     buffer.size() / sizeof(wchar_t));
+  return true;
+}
+
+// Creates an instance of the activation pipe that only the current user can
+// open. FILE_FLAG_FIRST_PIPE_INSTANCE on the first instance fails if another
+// process already owns the name, rather than sharing it with a squatter.
+HANDLE CreatePipeInstance(const std::wstring &pipeName, bool first) {
+  HANDLE token = nullptr;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &token))
+    return INVALID_HANDLE_VALUE;
+  BYTE userBuffer[SECURITY_MAX_SID_SIZE + sizeof(TOKEN_USER)];
+  DWORD userSize = 0;
+  BOOL gotUser = GetTokenInformation(token, TokenUser, userBuffer,
+                                     sizeof(userBuffer), &userSize);
+  CloseHandle(token);
+  LPWSTR userSid = nullptr;
+  if (!gotUser ||
+      !ConvertSidToStringSidW(
+          reinterpret_cast<TOKEN_USER *>(userBuffer)->User.Sid, &userSid))
+    return INVALID_HANDLE_VALUE;
+
+  // Full access for this user only; no inherited entries.
+  std::wstring sddl = L"D:P(A;;GA;;;" + std::wstring(userSid) + L")";
+  LocalFree(userSid);
+  SECURITY_ATTRIBUTES attributes{sizeof(attributes), nullptr, FALSE};
+  if (!ConvertStringSecurityDescriptorToSecurityDescriptorW(
+          sddl.c_str(), SDDL_REVISION_1, &attributes.lpSecurityDescriptor,
+          nullptr))
+    return INVALID_HANDLE_VALUE;
+
+  HANDLE pipe = CreateNamedPipeW(
+      pipeName.c_str(),
+      PIPE_ACCESS_INBOUND | (first ? FILE_FLAG_FIRST_PIPE_INSTANCE : 0),
+      PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT |
+          PIPE_REJECT_REMOTE_CLIENTS,
+      PIPE_UNLIMITED_INSTANCES, 0, kMaxPayloadBytes, 0, &attributes);
+  LocalFree(attributes.lpSecurityDescriptor);
+  return pipe;
+}
+
+void ListenLoop(std::wstring pipeName, HANDLE pipe,
+                std::function<void(std::vector<std::string>)> onActivation) {
+  ScopedWorkClass workClass{WorkClass::Utility};
+
+  while (!g_stopping.load()) {
+    bool connected = ConnectNamedPipe(pipe, nullptr) ||
+                     GetLastError() == ERROR_PIPE_CONNECTED;
+    // Put the next instance up before handling this connection so the name
+    // never goes away and a concurrent launch is not turned away.
+    HANDLE next = g_stopping.load() ? INVALID_HANDLE_VALUE
+                                    : CreatePipeInstance(pipeName, false);
+    std::vector<wchar_t> payload;
+    bool received = connected && !g_stopping.load() &&
+                    ReadMessage(pipe, payload);
+    DisconnectNamedPipe(pipe);
+    CloseHandle(pipe);
+
+    if (received) {
+      if (auto args = DecodePayload(payload))
+        onActivation(std::move(*args));
+      else
+        OutputDebugStringW(
+            L"[SingleInstance] Dropped an activation with invalid UTF-16\n");
+    }
+    if (next == INVALID_HANDLE_VALUE) {
+      if (!g_stopping.load())
+        OutputDebugStringW(L"[SingleInstance] CreateNamedPipeW failed\n");
+      return;
+    }
+    pipe = next;
+  }
+  CloseHandle(pipe);
+}
+
+} // namespace
+
+bool AcquireSingleInstance() noexcept {
+  g_mutex = CreateMutexW(nullptr, TRUE, L"Local\\StarterApp.SingleInstance");
+  if (g_mutex == nullptr)
+    return true; // Can't tell; behave as before rather than refusing to start
+  if (GetLastError() == ERROR_ALREADY_EXISTS)
+    return false;
+
+  g_firstPipe = CreatePipeInstance(PipeName(), true);
+  if (g_firstPipe == INVALID_HANDLE_VALUE)
+    OutputDebugStringW(L"[SingleInstance] CreateNamedPipeW failed\n");
+  return true;
+}
+
+bool ForwardActivation(const std::vector<std::wstring> &args) noexcept {
+  // The primary may hold the mutex but not have created the pipe yet, or be
+  // serving another launch; keep trying until the deadline.
+  std::wstring pipeName = PipeName();
+  ULONGLONG deadline = GetTickCount64() + kConnectTimeoutMs;
+  HANDLE pipe = INVALID_HANDLE_VALUE;
+  for (;;) {
+    pipe = CreateFileW(pipeName.c_str(), GENERIC_WRITE, 0, nullptr,
+                       OPEN_EXISTING, 0, nullptr);
+    if (pipe != INVALID_HANDLE_VALUE)
+      break;
+    DWORD error = GetLastError();
+    ULONGLONG now = GetTickCount64();
+    if ((error != ERROR_FILE_NOT_FOUND && error != ERROR_PIPE_BUSY) ||
+        now >= deadline)
+      return false;
+    // WaitNamedPipeW returns at once while the name does not exist.
+    if (error == ERROR_FILE_NOT_FOUND ||
+        !WaitNamedPipeW(pipeName.c_str(), static_cast<DWORD>(deadline - now)))
+      Sleep(kConnectRetryMs);
+  }
+
+  std::wstring payload;
+  for (const auto &arg : args) {
+    payload += arg;
+    payload.push_back(L'\0');
+  }
+
+  // Let the primary bring its window to the foreground.
+  AllowSetForegroundWindow(ASFW_ANY);
+
+  DWORD written = 0;
+  DWORD size = static_cast<DWORD>(payload.size() * sizeof(wchar_t));
+  BOOL ok = WriteFile(pipe, payload.data(), size, &written, nullptr);
+  CloseHandle(pipe);
+  return ok && written == size;
+}
+
+void StartActivationListener(
+    std::function<void(std::vector<std::string>)> onActivation) noexcept {
+  if (g_firstPipe == INVALID_HANDLE_VALUE)
+    return;
+  g_stopping = false;
+  g_listener = std::thread(ListenLoop, PipeName(), g_firstPipe,
+                           std::move(onActivation));
+  g_firstPipe = INVALID_HANDLE_VALUE;
+}
+
+void StopActivationListener() noexcept {
+  if (!g_listener.joinable())
+    return;
+  g_stopping = true;
+  // Unblock ConnectNamedPipe with a connection of our own.
+  HANDLE pipe = CreateFileW(PipeName().c_str(), GENERIC_WRITE, 0, nullptr,
+                            OPEN_EXISTING, 0, nullptr);
+  if (pipe != INVALID_HANDLE_VALUE)
+    CloseHandle(pipe);
+  g_listener.join();
+}
+
+std::vector<std::wstring> CommandLineArgs() noexcept {
+  std::vector<std::wstring> args;
+  int argc = 0;
+  LPWSTR *argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+  if (argv == nullptr)
+    return args;
+  for (int i = 1; i < argc; i++)
+    args.emplace_back(argv[i]);
+  LocalFree(argv);
+  return args;
+}
+
+} // namespace StarterApp
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "pch.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace StarterApp {
+
+// Claims the per-session single-instance mutex. Returns true if this process
+// is the primary instance; the mutex is held until the process exits. The
+// primary also creates its activation pipe here, so call this before
+// creating any window: activations that arrive before the listener starts
+// wait in the pipe.
+bool AcquireSingleInstance() noexcept;
+
+// Sends `args` to the primary instance over its activation pipe, retrying for
+// a few seconds while the primary starts up or is busy. Returns true once the
+// primary has received them, false if it could not be reached (the caller
+// should then start normally).
+bool ForwardActivation(const std::vector<std::wstring> &args) noexcept;
+
+// Starts a background thread that serves the activation pipe and calls
+// `onActivation` with each forwarded argument list (as UTF-8), on that thread.
+// Does nothing if AcquireSingleInstance did not create the pipe.
+void StartActivationListener(
+    std::function<void(std::vector<std::string>)> onActivation) noexcept;
+
+// Stops the listener thread started by StartActivationListener.
+void StopActivationListener() noexcept;
+
+// This process's command-line arguments, excluding the executable path.
+std::vector<std::wstring> CommandLineArgs() noexcept;
+
+} // namespace StarterApp
@@ -0,0 +1,78 @@
+#include "StallDetector.h"
+
+#include <algorithm>
+
+namespace StarterApp {
+
+StallDetector::StallDetector(size_t threadCount, uint32_t thresholdMs,
+                             uint32_t heartbeatMs, size_t maxSamples,
+                             uint64_t now)
+    : m_threads(threadCount),
+      m_thresholdMs(thresholdMs),
+      m_heartbeatMs(std::max(heartbeatMs, thresholdMs)),
+      m_maxSamples(maxSamples),
+      m_now(now) {}
+
+void StallDetector::Begin(uint64_t now) {
+  // A late wake-up means the whole process was not running (system sleep,
+  // debugger); don't blame the watched threads for it.
+  m_processPaused = now - m_now > uint64_t{m_waitMs} + m_thresholdMs;
+  m_now = now;
+  m_beatDue = now >= m_nextBeat;
+  m_awaitingBeat = false;
+}
+
+StallDetector::Step StallDetector::Update(size_t thread, bool heartbeatPending,
+                                          uint64_t beatAt) {
+  ThreadState &state = m_threads[thread];
+  Step step;
+
+  if (!heartbeatPending) {
+    if (state.stalled) {
+      step.recoveredAfterMs =
+          beatAt > state.postedAt ? beatAt - state.postedAt : 0;
+      state.stalled = false;
+    }
+    if (m_beatDue) {
+      state.postedAt = m_now;
+      step.postHeartbeat = true;
+      m_awaitingBeat = true;
+    }
+    return step;
+  }
+
+  m_awaitingBeat = true;
+  if (!state.stalled) {
+    if (m_processPaused) {
+      // Restart the measurement from now.
+      state.postedAt = m_now;
+      return step;
+    }
+    if (m_now - state.postedAt < m_thresholdMs)
+      return step;
+    state.stalled = true;
+    state.samples = 0;
+    state.sampledAt = 0;
+  }
+
+  if (state.samples >= m_maxSamples ||
+      (state.sampledAt != 0 && m_now - state.sampledAt < m_thresholdMs))
+    return step;
+  state.sampledAt = m_now;
+  state.samples++;
+  step.sampleStack = true;
+  step.stalledMs = m_now - state.postedAt;
+  return step;
+}
+
+uint32_t StallDetector::End() {
+  if (m_beatDue)
+    m_nextBeat = m_now + m_heartbeatMs;
+  // Check back one threshold after a heartbeat (and every threshold while a
+  // thread stays stalled); otherwise sleep until the next heartbeat.
+  m_waitMs = m_awaitingBeat ? m_thresholdMs
+                            : static_cast<uint32_t>(m_nextBeat - m_now);
+  return m_waitMs;
+}
+
+} // namespace StarterApp
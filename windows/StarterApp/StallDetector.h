@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace StarterApp {
+
+// The watchdog's heartbeat and stall bookkeeping, kept free of Win32 so it
+// can be tested on its own. The watcher thread calls Begin() when it wakes,
+// Update() for each watched thread, then End() for how long to sleep. Times
+// are milliseconds on one monotonic clock (GetTickCount64 in the app).
+//
+// Not thread-safe: owned by the watcher thread.
+class StallDetector {
+ public:
+  // What the watcher should do for one thread on this tick.
+  struct Step {
+    // Post a heartbeat to the thread.
+    bool postHeartbeat{false};
+    // Sample the thread's stack; it has been stalled for `stalledMs`.
+    bool sampleStack{false};
+    uint64_t stalledMs{0};
+    // Set once, when a stalled thread answers its heartbeat: how long the
+    // heartbeat waited.
+    std::optional<uint64_t> recoveredAfterMs;
+  };
+
+  // Heartbeats go out every `heartbeatMs` (at least `thresholdMs`); a thread
+  // whose heartbeat waits `thresholdMs` is stalled and gets up to
+  // `maxSamples` stack samples, a threshold apart.
+  StallDetector(size_t threadCount, uint32_t thresholdMs, uint32_t heartbeatMs,
+                size_t maxSamples, uint64_t now);
+
+  void Begin(uint64_t now);
+
+  // `heartbeatPending`: the last heartbeat posted to `thread` has not run.
+  // `beatAt`: when the last heartbeat did run.
+  Step Update(size_t thread, bool heartbeatPending, uint64_t beatAt);
+
+  // Returns how long to wait before the next Begin().
+  uint32_t End();
+
+ private:
+  struct ThreadState {
+    uint64_t postedAt{0};
+    uint64_t sampledAt{0};
+    size_t samples{0};
+    bool stalled{false};
+  };
+
+  std::vector<ThreadState> m_threads;
+  const uint32_t m_thresholdMs;
+  const uint32_t m_heartbeatMs;
+  const size_t m_maxSamples;
+
+  uint64_t m_now;
+  uint64_t m_nextBeat{0};
+  uint32_t m_waitMs{0};
+  bool m_beatDue{false};
+  bool m_awaitingBeat{false};
+  bool m_processPaused{false};
+};
+
+} // namespace StarterApp
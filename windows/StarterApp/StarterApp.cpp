@@ -8,7 +8,18 @@
 
 #include "NativeModules.h"
 
+#include "AuthUiBackend.h"
+#include "BackupModule.h"
+#include "DiagnosticsModule.h"
+#include "NetworkModule.h"
+#include "OcclusionMonitor.h"
+#include "Profiler.h"
+#include "SingleInstance.h"
+#include "WatchdogModule.h"
 #include "WebAuthModule.h"
+#include "WindowModule.h"
+
+#include <algorithm>
 
 // A PackageProvider containing any turbo modules you define within this app project
 struct CompReactPackageProvider
@@ -21,6 +32,21 @@ struct CompReactPackageProvider
 
 // The entry point of the Win32 application
 _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE, PSTR /* commandLine */, int showCmd) {
+  // A second launch (including an OAuth redirect to our URI scheme) hands its
+  // arguments to the running instance and exits before booting React Native.
+  // The primary creates its activation pipe here, before any window exists.
+  bool primaryInstance = StarterApp::AcquireSingleInstance();
+  if (!primaryInstance && StarterApp::ForwardActivation(StarterApp::CommandLineArgs())) {
+    return 0;
+  }
+
+  // `--profile` samples every thread from startup until exit and writes a
+  // pprof file to the temp directory.
+  auto args = StarterApp::CommandLineArgs();
+  if (std::find(args.begin(), args.end(), L"--profile") != args.end()) {
+    StarterApp::StartProfiler();
+  }
+
   // Initialize WinRT
   winrt::init_apartment(winrt::apartment_type::single_threaded);
 
@@ -65,10 +91,54 @@ _Use_decl_annotations_ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE, PSTR
   appWindow.Title(L"Starter App");
   appWindow.Resize({1000, 800});
 
+  // Report minimize / restore and occlusion so JS can throttle timers and
+  // background work
+  appWindow.Changed([](winrt::Microsoft::UI::Windowing::AppWindow const &window,
+                       winrt::Microsoft::UI::Windowing::AppWindowChangedEventArgs const &args) {
+    if (!args.DidVisibilityChange() && !args.DidPresenterChange() && !args.DidSizeChange()) {
+      return;
+    }
+    bool minimized = false;
+    if (auto presenter = window.Presenter().try_as<winrt::Microsoft::UI::Windowing::OverlappedPresenter>()) {
+      minimized = presenter.State() == winrt::Microsoft::UI::Windowing::OverlappedPresenterState::Minimized;
+    }
+    StarterApp::WindowModule::SetShown(window.IsVisible() && !minimized);
+  });
+  StarterApp::StartOcclusionMonitor(
+      winrt::Microsoft::UI::GetWindowFromWindowId(appWindow.Id()),
+      [](bool occluded) { StarterApp::WindowModule::SetOccluded(occluded); });
+
+  if (primaryInstance) {
+    // Sign-in redirects arrive as activations, so the loopback listener is
+    // not needed. Packaged builds can't register the scheme and keep it.
+    if (StarterApp::CanUseProtocolAuthUi()) {
+      StarterApp::WebAuthModule::SetAuthUiBackend(StarterApp::CreateProtocolAuthUiBackend());
+    }
+
+    HWND hwnd = winrt::Microsoft::UI::GetWindowFromWindowId(appWindow.Id());
+    StarterApp::StartActivationListener([hwnd](std::vector<std::string> args) {
+      for (const auto &arg : args) {
+        StarterApp::DeliverAuthActivation(arg);
+      }
+      if (IsIconic(hwnd)) {
+        ShowWindow(hwnd, SW_RESTORE);
+      }
+      SetForegroundWindow(hwnd);
+    });
+  }
+
   // Get the ReactViewOptions so we can set the initial RN component to load
   auto viewOptions{reactNativeWin32App.ReactViewOptions()};
   viewOptions.ComponentName(L"main");
 
   // Start the app
   reactNativeWin32App.Start();
+
+  StarterApp::StopOcclusionMonitor();
+  StarterApp::StopActivationListener();
+  if (StarterApp::IsProfilerRunning()) {
+    std::wstring profilePath = StarterApp::StopProfiler();
+    OutputDebugStringW((L"[Profiler] wrote " + profilePath + L"\n").c_str());
+  }
+  return 0;
 }
@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "ThreadQos.h"
+
+#include <atomic>
+#include <cassert>
+
+namespace StarterApp {
+
+namespace {
+
+// CPU time per WorkClass in 100ns units (FILETIME resolution).
+std::atomic<uint64_t> g_cpuTime[kWorkClassCount];
+
+// Innermost live scope on this thread.
+thread_local ScopedWorkClass *t_innermost{nullptr};
+
+uint64_t CurrentThreadCpuTime() noexcept {
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+    return 0;
+  auto toUInt64 = [](const FILETIME &ft) {
+    return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+  };
+  return toUInt64(kernel) + toUInt64(user);
+}
+
+// EcoQoS: with EXECUTION_SPEED in both masks the scheduler may run the thread
+// on efficient cores at reduced clock speed; in the control mask only, the
+// thread opts out; with both masks empty the system decides again. Ignored on
+// Windows versions without power throttling.
+void SetPowerThrottling(ULONG controlMask, ULONG stateMask) noexcept {
+  THREAD_POWER_THROTTLING_STATE state{};
+  state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+  state.ControlMask = controlMask;
+  state.StateMask = stateMask;
+  SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state,
+                       sizeof(state));
+}
+
+// Reads the thread's power-throttling state. Fails on Windows versions that
+// can't query it; the system-managed default ({0, 0}) is then the best guess.
+bool GetPowerThrottling(THREAD_POWER_THROTTLING_STATE &state) noexcept {
+  state = {};
+  state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+  return GetThreadInformation(GetCurrentThread(), ThreadPowerThrottling,
+                              &state, sizeof(state));
+}
+
+} // namespace
+
+ScopedWorkClass::ScopedWorkClass(WorkClass workClass,
+                                 DWORD_PTR affinityMask) noexcept
+    : m_workClass(workClass),
+      m_outer(t_innermost),
+      m_startCpuTime(CurrentThreadCpuTime()) {
+  HANDLE thread = GetCurrentThread();
+  t_innermost = this;
+
+  // Background mode is a per-thread switch, not a priority level: entering
+  // it twice (or leaving it when not in it) fails, so only toggle it when
+  // this scope changes it.
+  bool wasBackground =
+      m_outer != nullptr && m_outer->m_workClass == WorkClass::Background;
+  if (wasBackground && workClass != WorkClass::Background)
+    SetThreadPriority(thread, THREAD_MODE_BACKGROUND_END);
+  m_previousPriority = GetThreadPriority(thread);
+
+  if (workClass != WorkClass::Utility) {
+    if (!GetPowerThrottling(m_previousThrottling))
+      m_previousThrottling = {THREAD_POWER_THROTTLING_CURRENT_VERSION, 0, 0};
+    m_restoreThrottling = true;
+  }
+
+  switch (workClass) {
+    case WorkClass::Interactive:
+      SetThreadPriority(thread, THREAD_PRIORITY_NORMAL);
+      SetPowerThrottling(THREAD_POWER_THROTTLING_EXECUTION_SPEED, 0);
+      break;
+    case WorkClass::Utility:
+      SetThreadPriority(thread, THREAD_PRIORITY_BELOW_NORMAL);
+      break;
+    case WorkClass::Background:
+      // Background mode also lowers I/O and memory priority.
+      if (!wasBackground)
+        SetThreadPriority(thread, THREAD_MODE_BACKGROUND_BEGIN);
+      SetPowerThrottling(THREAD_POWER_THROTTLING_EXECUTION_SPEED,
+                         THREAD_POWER_THROTTLING_EXECUTION_SPEED);
+      break;
+  }
+
+  if (affinityMask != 0)
+    m_previousAffinity = SetThreadAffinityMask(thread, affinityMask);
+}
+
+ScopedWorkClass::~ScopedWorkClass() noexcept {
+  assert(t_innermost == this && "ScopedWorkClass scopes must nest");
+  HANDLE thread = GetCurrentThread();
+  // Time spent in nested scopes was charged to their own classes; hand this
+  // scope's total up so the enclosing one doesn't count it again.
+  uint64_t elapsed = CurrentThreadCpuTime() - m_startCpuTime;
+  g_cpuTime[static_cast<size_t>(m_workClass)].fetch_add(
+      elapsed - m_nestedCpuTime, std::memory_order_relaxed);
+  if (m_outer)
+    m_outer->m_nestedCpuTime += elapsed;
+
+  if (m_previousAffinity != 0)
+    SetThreadAffinityMask(thread, m_previousAffinity);
+
+  if (m_restoreThrottling)
+    SetPowerThrottling(m_previousThrottling.ControlMask,
+                       m_previousThrottling.StateMask);
+
+  bool wasBackground =
+      m_outer != nullptr && m_outer->m_workClass == WorkClass::Background;
+  if (m_workClass == WorkClass::Background && !wasBackground)
+    SetThreadPriority(thread, THREAD_MODE_BACKGROUND_END);
+  SetThreadPriority(thread, m_previousPriority);
+  if (m_workClass != WorkClass::Background && wasBackground)
+    SetThreadPriority(thread, THREAD_MODE_BACKGROUND_BEGIN);
+
+  t_innermost = m_outer;
+}
+
+uint64_t WorkClassCpuTimeMs(WorkClass workClass) noexcept {
+  return g_cpuTime[static_cast<size_t>(workClass)].load(
+             std::memory_order_relaxed) /
+         10000;
+}
+
+} // namespace StarterApp
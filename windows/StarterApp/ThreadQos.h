@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+
+namespace StarterApp {
+
+// Scheduling class for native work. Each class maps to an OS policy:
+//   Interactive - normal priority, never power-throttled (user is waiting)
+//   Utility     - below-normal priority (user-initiated but not latency-critical)
+//   Background  - background mode (lowest CPU and I/O priority) plus EcoQoS
+// Windows only: the macOS target has no app-owned native worker threads (if
+// it gains some, they map to QOS_CLASS_USER_INTERACTIVE / UTILITY /
+// BACKGROUND), and there is no Linux target.
+enum class WorkClass { Interactive = 0, Utility = 1, Background = 2 };
+
+constexpr size_t kWorkClassCount = 3;
+
+// Applies the policy for a WorkClass to the calling thread for the lifetime
+// of the scope, optionally pinning it to `affinityMask`, and charges the
+// thread's CPU time spent inside the scope, less that of nested scopes, to
+// that class. On exit the thread's previous priority, power-throttling state
+// and background mode are restored. Scopes may nest (in any combination of
+// classes) but must be destroyed in reverse order on the thread that created
+// them.
+class ScopedWorkClass {
+ public:
+  explicit ScopedWorkClass(WorkClass workClass,
+                           DWORD_PTR affinityMask = 0) noexcept;
+  ~ScopedWorkClass() noexcept;
+
+  ScopedWorkClass(const ScopedWorkClass &) = delete;
+  ScopedWorkClass &operator=(const ScopedWorkClass &) = delete;
+
+ private:
+  WorkClass m_workClass;
+  ScopedWorkClass *m_outer;
+  int m_previousPriority{THREAD_PRIORITY_NORMAL};
+  DWORD_PTR m_previousAffinity{0};
+  THREAD_POWER_THROTTLING_STATE m_previousThrottling{};
+  bool m_restoreThrottling{false};
+  uint64_t m_startCpuTime;
+  // CPU time of completed nested scopes, charged to their classes instead.
+  uint64_t m_nestedCpuTime{0};
+};
+
+// Total CPU time (user + kernel), in milliseconds, charged to a WorkClass by
+// completed ScopedWorkClass scopes since process start.
+uint64_t WorkClassCpuTimeMs(WorkClass workClass) noexcept;
+
+} // namespace StarterApp
@@ -0,0 +1,125 @@
+#include "Utf.h"
+
+#include "UtfConverter.h"
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define STARTERAPP_UTF_SSE2 1
+#elif defined(_M_ARM64)
+#include <arm64_neon.h>
+#define STARTERAPP_UTF_NEON 1
+#endif
+
+namespace StarterApp {
+
+using detail::ConvertUtf16ToUtf8;
+using detail::ConvertUtf8ToUtf16;
+
+namespace {
+
+// Widens the leading ASCII run of `in` into `out` (which must have room for
+// in.size() code units) and returns its length.
+size_t WidenAsciiPrefix(std::string_view in, wchar_t *out) noexcept {
+  const auto *src = reinterpret_cast<const uint8_t *>(in.data());
+  size_t size = in.size();
+  size_t i = 0;
+#if defined(STARTERAPP_UTF_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= size; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (_mm_movemask_epi8(bytes) != 0)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 8),
+                     _mm_unpackhi_epi8(bytes, zero));
+  }
+#elif defined(STARTERAPP_UTF_NEON)
+  for (; i + 16 <= size; i += 16) {
+    uint8x16_t bytes = vld1q_u8(src + i);
+    if (vmaxvq_u8(bytes) >= 0x80)
+      break;
+    vst1q_u16(reinterpret_cast<uint16_t *>(out + i),
+              vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(reinterpret_cast<uint16_t *>(out + i + 8),
+              vmovl_u8(vget_high_u8(bytes)));
+  }
+#endif
+  for (; i < size && src[i] < 0x80; i++)
+    out[i] = static_cast<wchar_t>(src[i]);
+  return i;
+}
+
+// Narrows the leading ASCII run of `in` into `out` (which must have room for
+// in.size() bytes) and returns its length.
+size_t NarrowAsciiPrefix(std::wstring_view in, char *out) noexcept {
+  size_t size = in.size();
+  size_t i = 0;
+#if defined(STARTERAPP_UTF_SSE2) || defined(STARTERAPP_UTF_NEON)
+  // wchar_t is a UTF-16 code unit wherever the vector paths are built.
+  const auto *src = reinterpret_cast<const uint16_t *>(in.data());
+#endif
+#if defined(STARTERAPP_UTF_SSE2)
+  const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+  for (; i + 16 <= size; i += 16) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+    __m128i high = _mm_and_si128(_mm_or_si128(lo, hi), nonAscii);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) !=
+        0xFFFF)
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+#elif defined(STARTERAPP_UTF_NEON)
+  for (; i + 16 <= size; i += 16) {
+    uint16x8_t lo = vld1q_u16(src + i);
+    uint16x8_t hi = vld1q_u16(src + i + 8);
+    if (vmaxvq_u16(vorrq_u16(lo, hi)) >= 0x80)
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t *>(out + i),
+             vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+  }
+#endif
+  for (; i < size && static_cast<uint32_t>(in[i]) < 0x80; i++)
+    out[i] = static_cast<char>(in[i]);
+  return i;
+}
+
+} // namespace
+
+std::optional<std::wstring> Utf8ToUtf16(std::string_view utf8) {
+  // UTF-16 never needs more code units than the UTF-8 input has bytes.
+  std::wstring result(utf8.size(), L'\0');
+  size_t ascii = WidenAsciiPrefix(utf8, result.data());
+  if (ascii == utf8.size())
+    return result;
+
+  std::string_view rest = utf8.substr(ascii);
+  int length = ConvertUtf8ToUtf16(rest, result.data() + ascii,
+                                  result.size() - ascii);
+  if (length < 0)
+    return std::nullopt;
+  result.resize(ascii + length);
+  return result;
+}
+
+std::optional<std::string> Utf16ToUtf8(std::wstring_view utf16) {
+  std::string result(utf16.size(), '\0');
+  size_t ascii = NarrowAsciiPrefix(utf16, result.data());
+  if (ascii == utf16.size())
+    return result;
+
+  std::wstring_view rest = utf16.substr(ascii);
+  int length = ConvertUtf16ToUtf8(rest, nullptr, 0);
+  if (length < 0)
+    return std::nullopt;
+  result.resize(ascii + length);
+  ConvertUtf16ToUtf8(rest, result.data() + ascii, length);
+  return result;
+}
+
+} // namespace StarterApp
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace StarterApp {
+
+// UTF-8 <-> UTF-16 conversion for Win32 / WinRT boundaries. Runs of ASCII
+// (the common case for URLs, hosts and error codes) are converted 16 code
+// units at a time with SSE2 / NEON; the rest goes through the system
+// converter with strict validation (see UtfConverter.h).
+
+// Returns nullopt if `utf8` is not well-formed UTF-8 (overlong forms,
+// surrogates, truncated sequences, bytes above U+10FFFF).
+std::optional<std::wstring> Utf8ToUtf16(std::string_view utf8);
+
+// Returns nullopt if `utf16` contains an unpaired surrogate.
+std::optional<std::string> Utf16ToUtf8(std::wstring_view utf16);
+
+} // namespace StarterApp
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace StarterApp::detail {
+
+// The non-ASCII half of Utf.cpp: strict UTF-8 <-> UTF-16 conversion of
+// whatever follows the ASCII prefix. The app links the Win32 converter
+// (UtfConverterWin32.cpp); the unit tests link a portable one so the ASCII
+// fast paths and the split between the two can be tested off Windows.
+
+// Converts `in` into `out` (room for `capacity` code units) and returns the
+// number written, or -1 if `in` is not well-formed UTF-8.
+int ConvertUtf8ToUtf16(std::string_view in, wchar_t *out, size_t capacity);
+
+// Returns the UTF-8 length of `in`, or -1 if it has an unpaired surrogate.
+// Writes the bytes only when `out` is non-null (room for `capacity` bytes).
+int ConvertUtf16ToUtf8(std::wstring_view in, char *out, size_t capacity);
+
+} // namespace StarterApp::detail
@@ -0,0 +1,21 @@
+#include "pch.h"
+#include "UtfConverter.h"
+
+namespace StarterApp::detail {
+
+int ConvertUtf8ToUtf16(std::string_view in, wchar_t *out, size_t capacity) {
+  int length = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, in.data(),
+                                   static_cast<int>(in.size()), out,
+                                   static_cast<int>(capacity));
+  return length > 0 ? length : -1;
+}
+
+int ConvertUtf16ToUtf8(std::wstring_view in, char *out, size_t capacity) {
+  int length = WideCharToMultiByte(CP_UTF8, WC_ERR_INVALID_CHARS, in.data(),
+                                   static_cast<int>(in.size()), out,
+                                   static_cast<int>(capacity), nullptr,
+                                   nullptr);
+  return length > 0 ? length : -1;
+}
+
+} // namespace StarterApp::detail
@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "WatchdogModule.h"
+
+#include "DiagnosticLog.h"
+#include "Profiler.h"
+#include "StallDetector.h"
+#include "ThreadQos.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace StarterApp {
+
+namespace {
+
+// Stack samples kept per stall; later ones are taken a threshold apart.
+constexpr size_t kMaxStallSamples = 4;
+constexpr uint32_t kMinThresholdMs = 100;
+constexpr uint32_t kHeartbeatIntervalMs = 5000;
+
+} // namespace
+
+struct WatchdogModule::WatchedThread {
+  WatchedThread(const char *name, React::ReactDispatcher dispatcher)
+      : name(name), dispatcher(std::move(dispatcher)) {}
+
+  ~WatchedThread() {
+    if (HANDLE h = handle.load())
+      CloseHandle(h);
+  }
+
+  const char *name;
+  React::ReactDispatcher dispatcher;
+
+  // Set by the heartbeat on the watched thread.
+  std::atomic<HANDLE> handle{nullptr}; // opened by the first heartbeat
+  std::atomic<uintptr_t> stackBase{0};
+  std::atomic<bool> pending{false};
+  std::atomic<ULONGLONG> beatAt{0};
+
+  // Owned by the watcher thread: stacks sampled during the current stall.
+  std::vector<std::string> stacks;
+};
+
+void WatchdogModule::Initialize(
+    winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept {
+  m_reactContext = reactContext;
+}
+
+WatchdogModule::~WatchdogModule() noexcept {
+  stop();
+}
+
+void WatchdogModule::start(int thresholdMs) noexcept {
+  stop();
+  m_js = std::make_shared<WatchedThread>("js", m_reactContext.JSDispatcher());
+  m_ui = std::make_shared<WatchedThread>("ui", m_reactContext.UIDispatcher());
+  m_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (m_stopEvent == nullptr)
+    return;
+  uint32_t threshold =
+      std::max(kMinThresholdMs, static_cast<uint32_t>(std::max(thresholdMs, 0)));
+  m_watcher = std::thread([this, threshold] { WatchLoop(threshold); });
+}
+
+void WatchdogModule::stop() noexcept {
+  if (m_watcher.joinable()) {
+    SetEvent(m_stopEvent);
+    m_watcher.join();
+  }
+  if (m_stopEvent) {
+    CloseHandle(m_stopEvent);
+    m_stopEvent = nullptr;
+  }
+  // Heartbeats still queued hold their own references.
+  m_js.reset();
+  m_ui.reset();
+}
+
+void WatchdogModule::WatchLoop(uint32_t thresholdMs) noexcept {
+  ScopedWorkClass workClass{WorkClass::Utility};
+  SetThreadDescription(GetCurrentThread(), L"StarterApp watchdog");
+
+  // Heartbeats are spaced well apart so an idle app is not woken up often;
+  // a stall is measured from the heartbeat that catches it.
+  const std::shared_ptr<WatchedThread> threads[] = {m_js, m_ui};
+  StallDetector detector(std::size(threads), thresholdMs, kHeartbeatIntervalMs,
+                         kMaxStallSamples, GetTickCount64());
+  DWORD waitMs = 0;
+  StackSampler sampler;
+  uint64_t frames[kMaxStackFrames];
+
+  while (WaitForSingleObject(m_stopEvent, waitMs) == WAIT_TIMEOUT) {
+    detector.Begin(GetTickCount64());
+    for (size_t i = 0; i < std::size(threads); i++) {
+      WatchedThread &thread = *threads[i];
+      auto step = detector.Update(i, thread.pending.load(), thread.beatAt.load());
+      if (step.recoveredAfterMs) {
+        Report(thread, *step.recoveredAfterMs);
+        thread.stacks.clear();
+      }
+      if (step.postHeartbeat)
+        PostHeartbeat(threads[i]);
+
+      HANDLE handle = thread.handle.load();
+      if (!step.sampleStack || handle == nullptr)
+        continue;
+      size_t depth = sampler.Capture(handle, thread.stackBase.load(), frames,
+                                     kMaxStackFrames);
+      std::string stack = SymbolizeStack(frames, depth);
+      // Logged as it is taken so a thread that never recovers still leaves
+      // evidence behind.
+      std::string entry = "[Watchdog] " + std::string(thread.name) +
+                          " thread stalled for " +
+                          std::to_string(step.stalledMs) + "ms:\n" + stack;
+      OutputDebugStringA(entry.c_str());
+      AppendDiagnosticLog(entry);
+      thread.stacks.push_back(std::move(stack));
+    }
+    waitMs = detector.End();
+  }
+}
+
+void WatchdogModule::PostHeartbeat(
+    const std::shared_ptr<WatchedThread> &thread) {
+  thread->pending = true;
+  thread->dispatcher.Post([watched = thread] {
+    if (!watched->handle.load()) {
+      ULONG_PTR low = 0, high = 0;
+      GetCurrentThreadStackLimits(&low, &high);
+      watched->stackBase = high;
+      watched->handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT,
+                                   FALSE, GetCurrentThreadId());
+    }
+    watched->beatAt = GetTickCount64();
+    watched->pending = false;
+  });
+}
+
+void WatchdogModule::Report(WatchedThread &thread,
+                            uint64_t durationMs) noexcept {
+  std::string entry = "[Watchdog] " + std::string(thread.name) +
+                      " thread recovered after " + std::to_string(durationMs) +
+                      "ms\n";
+  OutputDebugStringA(entry.c_str());
+  AppendDiagnosticLog(entry);
+  if (!onStall)
+    return;
+  React::JSValueArray stacks;
+  for (auto &stack : thread.stacks)
+    stacks.push_back(React::JSValue{std::move(stack)});
+  React::JSValueObject stall;
+  stall["thread"] = std::string(thread.name);
+  stall["durationMs"] = static_cast<int64_t>(durationMs);
+  stall["stacks"] = std::move(stacks);
+  onStall(React::JSValue{std::move(stall)});
+}
+
+} // namespace StarterApp
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "pch.h"
+#include "NativeModules.h"
+#include <winrt/Microsoft.ReactNative.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace StarterApp {
+
+REACT_MODULE(WatchdogModule)
+struct WatchdogModule {
+  REACT_INIT(Initialize)
+  void Initialize(winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept;
+
+  ~WatchdogModule() noexcept;
+
+  // Starts posting heartbeats (every 5 s) to the JS and UI threads. A thread
+  // that takes longer than `thresholdMs` to run one is treated as stalled:
+  // its native stack is sampled into the diagnostic log (see DiagnosticLog.h)
+  // until it recovers. Restarts the watchdog if it is already running.
+  REACT_METHOD(start)
+  void start(int thresholdMs) noexcept;
+
+  REACT_METHOD(stop)
+  void stop() noexcept;
+
+  // Emitted (as a DeviceEventEmitter event) when a stalled thread recovers,
+  // with `{thread: 'js' | 'ui', durationMs, stacks}`.
+  REACT_EVENT(onStall, L"threadStalled")
+  std::function<void(React::JSValue)> onStall;
+
+ private:
+  struct WatchedThread;
+
+  void WatchLoop(uint32_t thresholdMs) noexcept;
+  static void PostHeartbeat(const std::shared_ptr<WatchedThread> &thread);
+  void Report(WatchedThread &thread, uint64_t durationMs) noexcept;
+
+  winrt::Microsoft::ReactNative::ReactContext m_reactContext;
+  std::shared_ptr<WatchedThread> m_js;
+  std::shared_ptr<WatchedThread> m_ui;
+  std::thread m_watcher;
+  HANDLE m_stopEvent{nullptr};
+};
+
+} // namespace StarterApp
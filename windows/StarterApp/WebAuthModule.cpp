@@ -1,23 +1,25 @@
 #include "pch.h"
 #include "WebAuthModule.h"
 
+#include "AuthFlow.h"
+#include "DiagnosticLog.h"
+#include "ThreadQos.h"
+
 #include <bcrypt.h>
 #include <wincrypt.h>
-#include <shellapi.h>
-#include <winsock2.h>
-#include <ws2tcpip.h>
 
 #include <string>
 #include <vector>
 #include <thread>
-#include <regex>
 
 #pragma comment(lib, "bcrypt.lib")
 #pragma comment(lib, "crypt32.lib")
-#pragma comment(lib, "ws2_32.lib")
 
 namespace StarterApp {
 
+std::mutex WebAuthModule::s_backendMutex;
+std::shared_ptr<IAuthUiBackend> WebAuthModule::s_backend;
+
 void WebAuthModule::Initialize(
     winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept {
   m_reactContext = reactContext;
@@ -116,116 +118,49 @@ void WebAuthModule::sha256(std::string input,
   result.Resolve(Base64UrlEncode(hashValue));
 }
 
+void WebAuthModule::SetAuthUiBackend(
+    std::shared_ptr<IAuthUiBackend> backend) noexcept {
+  std::lock_guard<std::mutex> lock(s_backendMutex);
+  s_backend = std::move(backend);
+}
+
+std::shared_ptr<IAuthUiBackend> WebAuthModule::GetAuthUiBackend() noexcept {
+  std::lock_guard<std::mutex> lock(s_backendMutex);
+  if (!s_backend)
+    s_backend = CreateLoopbackAuthUiBackend();
+  return s_backend;
+}
+
 void WebAuthModule::authenticate(
     std::string url, std::string callbackScheme,
     React::ReactPromise<React::JSValue> result) noexcept {
-  std::thread([url = std::move(url), callbackScheme = std::move(callbackScheme),
+  std::thread([backend = GetAuthUiBackend(), url = std::move(url),
+               callbackScheme = std::move(callbackScheme),
                result = std::move(result)]() mutable {
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
-      result.Reject(
-          React::ReactError{"SOCKET_ERROR", "Failed to initialize Winsock"});
-      return;
-    }
-
-    SOCKET listenSock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (listenSock == INVALID_SOCKET) {
-      WSACleanup();
-      result.Reject(
-          React::ReactError{"SOCKET_ERROR", "Failed to create socket"});
-      return;
-    }
-
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-    addr.sin_port = 0;
-
-    if (bind(listenSock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
-        SOCKET_ERROR) {
-      closesocket(listenSock);
-      WSACleanup();
-      result.Reject(
-          React::ReactError{"SOCKET_ERROR", "Failed to bind socket"});
-      return;
-    }
-
-    int addrLen = sizeof(addr);
-    getsockname(listenSock, reinterpret_cast<sockaddr *>(&addr), &addrLen);
-    int port = ntohs(addr.sin_port);
-
-    if (listen(listenSock, 1) == SOCKET_ERROR) {
-      closesocket(listenSock);
-      WSACleanup();
-      result.Reject(
-          React::ReactError{"SOCKET_ERROR", "Failed to listen on socket"});
-      return;
-    }
-
-    std::string redirectUri =
-        "http://127.0.0.1:" + std::to_string(port) + "/callback";
-
-    std::string fullUrl = url;
-    if (fullUrl.find('?') != std::string::npos)
-      fullUrl += "&redirect_uri=" + redirectUri;
-    else
-      fullUrl += "?redirect_uri=" + redirectUri;
-
-    std::wstring wUrl(fullUrl.begin(), fullUrl.end());
-    ShellExecuteW(nullptr, L"open", wUrl.c_str(), nullptr, nullptr,
-                  SW_SHOWNORMAL);
-
-    DWORD timeout = 60000;
-    setsockopt(listenSock, SOL_SOCKET, SO_RCVTIMEO,
-               reinterpret_cast<const char *>(&timeout), sizeof(timeout));
-
-    SOCKET clientSock = accept(listenSock, nullptr, nullptr);
-    if (clientSock == INVALID_SOCKET) {
-      closesocket(listenSock);
-      WSACleanup();
-      result.Resolve(React::JSValue{nullptr});
-      return;
-    }
-
-    char buf[4096];
-    int bytesRead = recv(clientSock, buf, sizeof(buf) - 1, 0);
-    if (bytesRead <= 0) {
-      closesocket(clientSock);
-      closesocket(listenSock);
-      WSACleanup();
-      result.Resolve(React::JSValue{nullptr});
-      return;
-    }
-    buf[bytesRead] = '\0';
-
-    const char *response =
-        "HTTP/1.1 200 OK\r\n"
-        "Content-Type: text/html\r\n"
-        "Connection: close\r\n\r\n"
-        "<html><body><p>Authentication complete. You may close this "
-        "tab.</p><script>window.close()</script></body></html>";
-    send(clientSock, response, static_cast<int>(strlen(response)), 0);
-    closesocket(clientSock);
-    closesocket(listenSock);
-    WSACleanup();
-
-    std::string request(buf);
-    std::regex requestLineRegex(R"(GET\s+(/\S+)\s+HTTP)");
-    std::smatch match;
-    if (std::regex_search(request, match, requestLineRegex)) {
-      std::string path = match[1].str();
-      auto qPos = path.find('?');
-      if (qPos == std::string::npos) {
-        result.Resolve(React::JSValue{nullptr});
-        return;
-      }
-      std::string callbackUrl =
-          callbackScheme + "://callback" + path.substr(qPos);
-      result.Resolve(React::JSValue{callbackUrl});
-    } else {
-      result.Resolve(React::JSValue{nullptr});
-    }
+    // Mostly blocked waiting for the user; keep it off the UI/JS threads' cores.
+    ScopedWorkClass workClass{WorkClass::Utility};
+
+    AuthAttempt attempt = RunAuthentication(
+        *backend, url, callbackScheme,
+        [&result](std::optional<std::string> callbackUrl) {
+          if (callbackUrl)
+            result.Resolve(React::JSValue{std::move(*callbackUrl)});
+          else
+            result.Resolve(React::JSValue{nullptr});
+        },
+        [&result](std::string code, std::string message) {
+          result.Reject(React::ReactError{std::move(code), std::move(message)});
+        });
+
+    // Sign-in time per backend, to compare them on real machines.
+    std::string entry = FormatAuthAttempt(*backend, attempt);
+    OutputDebugStringA(entry.c_str());
+    AppendDiagnosticLog(entry);
   }).detach();
 }
 
+void WebAuthModule::cancelAuthentication() noexcept {
+  GetAuthUiBackend()->Cancel();
+}
+
 } // namespace StarterApp
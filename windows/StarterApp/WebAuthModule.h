@@ -4,6 +4,11 @@
 #include "NativeModules.h"
 #include <winrt/Microsoft.ReactNative.h>
 
+#include "AuthUiBackend.h"
+
+#include <memory>
+#include <mutex>
+
 namespace StarterApp {
 
 REACT_MODULE(WebAuthModule)
@@ -21,8 +26,21 @@ struct WebAuthModule {
   void authenticate(std::string url, std::string callbackScheme,
                     React::ReactPromise<React::JSValue> result) noexcept;
 
+  // Ends a pending authenticate() with a null result, if its backend can be
+  // interrupted.
+  REACT_METHOD(cancelAuthentication)
+  void cancelAuthentication() noexcept;
+
+  // Replaces the UI used by authenticate() for subsequent sign-ins. Defaults
+  // to the system browser + loopback listener.
+  static void SetAuthUiBackend(std::shared_ptr<IAuthUiBackend> backend) noexcept;
+
  private:
   static std::string Base64UrlEncode(const std::vector<uint8_t> &data);
+  static std::shared_ptr<IAuthUiBackend> GetAuthUiBackend() noexcept;
+
+  static std::mutex s_backendMutex;
+  static std::shared_ptr<IAuthUiBackend> s_backend;
   winrt::Microsoft::ReactNative::ReactContext m_reactContext;
 };
 
@@ -0,0 +1,48 @@
+#include "pch.h"
+#include "WindowModule.h"
+
+namespace StarterApp {
+
+std::atomic<bool> WindowModule::s_shown{true};
+std::atomic<bool> WindowModule::s_occluded{false};
+std::atomic<bool> WindowModule::s_visible{true};
+std::mutex WindowModule::s_instanceMutex;
+WindowModule *WindowModule::s_instance{nullptr};
+
+void WindowModule::Initialize(
+    winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept {
+  m_reactContext = reactContext;
+  std::lock_guard<std::mutex> lock(s_instanceMutex);
+  s_instance = this;
+}
+
+WindowModule::~WindowModule() noexcept {
+  std::lock_guard<std::mutex> lock(s_instanceMutex);
+  if (s_instance == this)
+    s_instance = nullptr;
+}
+
+void WindowModule::isVisible(React::ReactPromise<bool> result) noexcept {
+  result.Resolve(s_visible.load());
+}
+
+void WindowModule::SetShown(bool shown) noexcept {
+  s_shown = shown;
+  UpdateVisible();
+}
+
+void WindowModule::SetOccluded(bool occluded) noexcept {
+  s_occluded = occluded;
+  UpdateVisible();
+}
+
+void WindowModule::UpdateVisible() noexcept {
+  bool visible = s_shown && !s_occluded;
+  if (s_visible.exchange(visible) == visible)
+    return;
+  std::lock_guard<std::mutex> lock(s_instanceMutex);
+  if (s_instance && s_instance->onVisibilityChanged)
+    s_instance->onVisibilityChanged(visible);
+}
+
+} // namespace StarterApp
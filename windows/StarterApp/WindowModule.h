@@ -0,0 +1,48 @@
+#pragma once
+
+#include "pch.h"
+#include "NativeModules.h"
+#include <winrt/Microsoft.ReactNative.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace StarterApp {
+
+REACT_MODULE(WindowModule)
+struct WindowModule {
+  REACT_INIT(Initialize)
+  void Initialize(winrt::Microsoft::ReactNative::ReactContext const &reactContext) noexcept;
+
+  ~WindowModule() noexcept;
+
+  // Resolves with whether the main window is currently visible: shown (not
+  // minimized or hidden) and not occluded.
+  REACT_METHOD(isVisible)
+  void isVisible(React::ReactPromise<bool> result) noexcept;
+
+  // Emitted (as a DeviceEventEmitter event) when the main window is
+  // minimized, hidden or occluded, or becomes visible again.
+  REACT_EVENT(onVisibilityChanged, L"windowVisibilityChanged")
+  std::function<void(bool)> onVisibilityChanged;
+
+  // Called by the host when the main window is shown or minimized / hidden.
+  static void SetShown(bool shown) noexcept;
+
+  // Called by the host's occlusion monitor (see OcclusionMonitor.h).
+  static void SetOccluded(bool occluded) noexcept;
+
+ private:
+  static void UpdateVisible() noexcept;
+
+  static std::atomic<bool> s_shown;
+  static std::atomic<bool> s_occluded;
+  static std::atomic<bool> s_visible;
+  static std::mutex s_instanceMutex;
+  static WindowModule *s_instance;
+
+  winrt::Microsoft::ReactNative::ReactContext m_reactContext;
+};
+
+} // namespace StarterApp